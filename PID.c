@@ -28,8 +28,14 @@
 #include "height.h"
 #include "yaw.h"
 #include "buttons.h"
+#include "flight.h"
 #include "PID.h"
 #include "UART.h"
+#include "actuator.h"
+#include "format.h"
+#include "cycles.h"
+#include "latency.h"
+#include "metrics.h"
 
 /**********************************************************
  * Defined constants
@@ -39,182 +45,209 @@
 #define PWM_MAIN_OUTBIT         PWM_OUT_7_BIT
 #define PWM_TAIL_BASE           PWM1_BASE
 #define PWM_TAIL_OUTBIT         PWM_OUT_5_BIT
-#define MAX_STR_LEN             16
-#define MAIN_PROPORTIONAL_GAIN  0.8
-#define MAIN_INTEGRAL_GAIN      0.01
-#define MAIN_DIFFERENTIAL_GAIN  0.01
-#define TAIL_PROPORTIONAL_GAIN  0.8
-#define TAIL_INTEGRAL_GAIN      0.01
-#define TAIL_DIFFERENTIAL_GAIN  0       // Can be adjusted for tail gain
+#define MAX_STR_LEN             64
 #define FALSE                   0
 #define TRUE                    1
-#define MIN_CYCL_RNG            5       // Minimum control duty cycle
-#define MAX_CYCL_RNG            95      // Maximum control duty cycle
-#define MIN_DTY_CYCL            0       // Minimum duty cycle
-#define MAX_DTY_CYCL            98      // Maximum duty cycle
-#define MAIN_OFFSET             10
-#define TAIL_STABALIZER         0.85    // Stabilizes and centers helicopter
-#define G_STATE_SIZE            20
+#define ALT_SETTLE_BAND         2       // Smallest altitude settling band, percent
+#define YAW_SETTLE_BAND         2       // Smallest yaw settling band, degrees
 
 /**********************************************************
  * Global variables
  **********************************************************/
 
-char g_status_str [ MAX_STR_LEN + 1 ];
-extern char g_state [ G_STATE_SIZE ];
-
-_Bool g_pwm_on = FALSE;
-
-float g_main_intgrl = 0;
-float g_main_dfrntl = 0;
-float g_main_last_error = 0;
-float g_tail_intgrl = 0;
-float g_tail_dfrntl = 0;
-float g_tail_last_error = 0;
-float g_main_integral_error = 0;
-float g_tail_integral_error = 0;
-float g_main_differential_error = 0;
-float g_tail_differential_error = 0;
-extern int g_duty_cycle_main;
-extern int g_duty_cycle_tail;
-extern int8_t g_altitude_percent;
-extern int16_t g_yaw_angle;
+static char g_status_str [ MAX_STR_LEN + 1 ];
 
 /**
  * This function ensures that the PWM outputs are disabled when the
  * helicopter is landed, and on when the helicopter is flying/calibrating
+ * @param heli  The rig
  */
 void
-PWMtoggle ( void )
+PWMtoggle ( heli_t *heli )
 {
-    if (( strcmp ( g_state, "Flying" ) == 0 || strcmp ( g_state, "Calibration" ) == 0 ) && !g_pwm_on )
+    if ( updateOutputEnable ( heli ))
     {
-        g_pwm_on = TRUE;
-        // Turn PWMs on
-        PWMOutputState ( PWM_MAIN_BASE, PWM_MAIN_OUTBIT, true );
-        PWMOutputState ( PWM_TAIL_BASE, PWM_TAIL_OUTBIT, true );
+        // Turns both PWMs on or off together
+        PWMOutputState ( PWM_MAIN_BASE, PWM_MAIN_OUTBIT, heli->actuators.pwm_on );
+        PWMOutputState ( PWM_TAIL_BASE, PWM_TAIL_OUTBIT, heli->actuators.pwm_on );
     }
+}
 
-    if ( strcmp ( g_state, "landed" ) == 0 && g_pwm_on && getAltitudePercentage () == 0 )
-    {
-        g_pwm_on = FALSE;
-        // Turn PWMs off
-        PWMOutputState ( PWM_MAIN_BASE, PWM_MAIN_OUTBIT, false );
-        PWMOutputState ( PWM_TAIL_BASE, PWM_TAIL_OUTBIT, false );
-    }
+/**
+ * Reads the altitude, yaw and their timestamps once for the control update
+ * @param heli  The rig
+ */
+void
+sampleSensors ( heli_t *heli )
+{
+    heli->sensors.altitude = getAltitudePercentage ();
+    heli->sensors.alt_time = getADCtime ();
+    heli->sensors.yaw = getYaw ();
+    heli->sensors.yaw_time = getYawTime ();
 }
 
 /**
- *  Controls helicopter height by altering the duty cycle of main PWM output
+ * Sends the latest main and tail outputs to the rotors in one synchronized
+ * update and records the time since the sensor readings they came from.
+ * Called after mainControl and tailControl
+ * @param heli  The rig
  */
 void
-mainControl ( void )
+applyControl ( heli_t *heli )
 {
-    //calculates the proportional and differential errors for the height
-    float main_error = g_altitude_percent - getAltitudePercentage ();
-    g_main_differential_error = main_error - g_main_last_error;
-    g_main_last_error = main_error;
+    actuators_t *out = &heli->actuators;
+
+    applyActuatorCommand ( out->main_command, out->tail_command );
 
-    //multiplies the three error signals by their respective gains
-    float main_prptnl = MAIN_PROPORTIONAL_GAIN * main_error;
-    g_main_intgrl =  MAIN_INTEGRAL_GAIN * g_main_integral_error;
-    g_main_dfrntl = MAIN_DIFFERENTIAL_GAIN * g_main_differential_error;
+    uint32_t now = getCycles ();
+    recordLatency ( LAT_ALT, now - heli->sensors.alt_time );
 
-    // Combines error signals into a single control signal to send to the motor
-    int main_control = MAIN_OFFSET + main_prptnl + g_main_intgrl + g_main_dfrntl;
+    // A yaw edge counts once, the update after it arrived
+    if ( heli->sensors.yaw_time != out->last_edge_time )
+    {
+        recordLatency ( LAT_YAW, now - heli->sensors.yaw_time );
+        out->last_edge_time = heli->sensors.yaw_time;
+    }
+}
 
-    g_duty_cycle_main = main_control;
+/**
+ * Restarts both trackers from the current targets and sample time
+ * @param heli  The rig
+ */
+static void
+resetControlMetrics ( heli_t *heli )
+{
+    initStepTracker ( &heli->metrics.alt_tracker, ALT_SETTLE_BAND, heli->setpoints.altitude );
+    initStepTracker ( &heli->metrics.yaw_tracker, YAW_SETTLE_BAND, heli->setpoints.yaw );
+    heli->metrics.sample_time = heli->sensors.alt_time;
+}
 
+/**
+ * Starts following setpoint changes from the current targets
+ * @param heli  The rig
+ */
+void
+initControlMetrics ( heli_t *heli )
+{
+    heli->metrics.cycles_per_us = SysCtlClockGet () / 1000000;
+    resetControlMetrics ( heli );
+}
 
-    // Prevents integrator wind-up when calculating the integral error
-    if ( g_duty_cycle_main > MIN_CYCL_RNG && g_duty_cycle_main < MAX_CYCL_RNG )
+/**
+ * Follows the response of both loops to setpoint changes. Only steps made
+ * while flying count, the take-off, calibration and landing sequences move
+ * the setpoints themselves. Called after each control update
+ * @param heli  The rig
+ */
+void
+updateControlMetrics ( heli_t *heli )
+{
+    controlMetrics_t *metrics = &heli->metrics;
+
+    if ( heli->fsm.state != STATE_FLYING )
     {
-        g_main_integral_error += main_error;
+        resetControlMetrics ( heli );
+        return;
     }
 
-    // Prevents the control signal exceeding the allowed duty cycle
-    g_main_integral_error += main_error;
+    // Timed from the ADC samples, so an update that ran late or after a
+    // missed tick is counted for the time that really passed
+    uint32_t elapsed = ( heli->sensors.alt_time - metrics->sample_time ) / metrics->cycles_per_us;
+    metrics->sample_time = heli->sensors.alt_time;
 
-    if ( g_duty_cycle_main < MIN_CYCL_RNG )
+    if ( updateStepTracker ( &metrics->alt_tracker, heli->setpoints.altitude, heli->sensors.altitude, elapsed,
+                             &metrics->alt_metrics ))
     {
-        g_duty_cycle_main = MIN_DTY_CYCL;
+        metrics->alt_report = TRUE;
     }
 
-    if ( g_duty_cycle_main >= MAX_CYCL_RNG )
+    if ( updateStepTracker ( &metrics->yaw_tracker, heli->setpoints.yaw, heli->sensors.yaw, elapsed,
+                             &metrics->yaw_metrics ))
     {
-        g_duty_cycle_main = MAX_DTY_CYCL;
+        metrics->yaw_report = TRUE;
     }
-
-    updateDisplayPWMmain ();
-
-    setPWMmain ( g_duty_cycle_main );
 }
 
 /**
-* Controls helicopter yaw by altering the duty cycle of the tail PWM output
-*/
+ * Sends a summary record for each step finished since the last call. Kept
+ * out of the control task so the UART never delays a control update
+ * @param heli  The rig
+ */
 void
-tailControl ( void )
+reportControlMetrics ( heli_t *heli )
 {
-    // Calculates the proportional and differential errors
-    float tail_error = g_yaw_angle - getYaw ();
-    g_tail_differential_error = tail_error - g_tail_last_error;
-    g_tail_last_error = tail_error;
-
-    // Multiplies the three error signals by their respective gains
-    float tail_prprtnl = TAIL_PROPORTIONAL_GAIN * tail_error;
-    g_tail_intgrl = TAIL_INTEGRAL_GAIN * g_tail_integral_error;
-    g_tail_dfrntl = TAIL_DIFFERENTIAL_GAIN * g_tail_differential_error;
-
-    // Combines error signals into a single control signal to send to the motor
-    int tail_control = tail_prprtnl + g_tail_intgrl + g_tail_dfrntl;
+    controlMetrics_t *metrics = &heli->metrics;
+    char record [ METRICS_RECORD_SIZE ];
 
-    g_duty_cycle_tail = ( g_duty_cycle_main * TAIL_STABALIZER + tail_control );
-
-    // Prevents integrator wind-up when calculating the integral error
-    if ( g_duty_cycle_tail > MIN_CYCL_RNG && g_duty_cycle_tail < MAX_CYCL_RNG )
+    if ( metrics->alt_report )
     {
-        g_tail_integral_error += tail_error;
+        metrics->alt_report = FALSE;
+        formatLiteral ( formatStepMetrics ( record, "step alt", &metrics->alt_metrics ), "\r\n" );
+        sendUART ( record );
     }
 
-    // Prevents the control signal exceeding the allowed duty cycle
-    if ( g_duty_cycle_tail < MIN_CYCL_RNG )
+    if ( metrics->yaw_report )
     {
-        g_duty_cycle_tail = MIN_DTY_CYCL;
+        metrics->yaw_report = FALSE;
+        formatLiteral ( formatStepMetrics ( record, "step yaw", &metrics->yaw_metrics ), "\r\n" );
+        sendUART ( record );
     }
-
-    if ( g_duty_cycle_tail >= MAX_CYCL_RNG )
-    {
-        g_duty_cycle_tail = MAX_DTY_CYCL;
-    }
-    updateDisplayPWMtail ();
-
-    setPWMtail ( g_duty_cycle_tail );
 }
 
 /**
  * Displays PID related information to a terminal for debugging purposes
+ * @param heli  The rig
  */
 void
-UARTmessage ( void )
+UARTmessage ( heli_t *heli )
 {
+    uint32_t sent = getUARTbytesSent ();
+
     // Displays the current and target yaw (�)
-    usprintf ( g_status_str, "Yaw: %2d [%2d] \r\n", ( int ) getYaw (), g_yaw_angle );
+    char *end = formatLiteral ( g_status_str, "Yaw: " );
+    end = formatInt ( end, getYaw (), 2 );
+    end = formatLiteral ( end, " [" );
+    end = formatInt ( end, heli->setpoints.yaw, 2 );
+    formatLiteral ( end, "] \r\n" );
     sendUART ( g_status_str );
 
     // Displays the current and target altitude (%)
-    usprintf ( g_status_str, "Alt: %2d [%2d] \r\n", ( int ) getAltitudePercentage (), g_altitude_percent );
+    end = formatLiteral ( g_status_str, "Alt: " );
+    end = formatInt ( end, getAltitudePercentage (), 2 );
+    end = formatLiteral ( end, " [" );
+    end = formatInt ( end, heli->setpoints.altitude, 2 );
+    formatLiteral ( end, "] \r\n" );
     sendUART ( g_status_str );
 
     // Displays the PWM for the main rotor motor
-    usprintf ( g_status_str, "Main %2d tail %2d \r\n", ( int ) g_duty_cycle_main, ( int ) g_duty_cycle_tail );
+    end = formatLiteral ( g_status_str, "Main " );
+    end = formatInt ( end, heli->actuators.main_duty, 2 );
+    end = formatLiteral ( end, " tail " );
+    end = formatInt ( end, heli->actuators.tail_duty, 2 );
+    formatLiteral ( end, " \r\n" );
     sendUART ( g_status_str );
 
     // Displays the PWM for the tail rotor motor
-    usprintf ( g_status_str, "Mode %s \r\n", g_state );
+    end = formatLiteral ( g_status_str, "Mode " );
+    end = formatString ( end, getState ( heli ));
+    formatLiteral ( end, " \r\n" );
+    sendUART ( g_status_str );
+    // Displays the yaw reference error statistics (ticks)
+    yawRefStats_t ref_stats = getYawRefStats ();
+    end = formatLiteral ( g_status_str, "Ref " );
+    end = formatInt ( end, ref_stats.last_error, 0 );
+    end = formatLiteral ( end, " max " );
+    end = formatInt ( end, ref_stats.max_error, 0 );
+    end = formatLiteral ( end, " n " );
+    end = formatInt ( end, ref_stats.passes, 0 );
+    end = formatLiteral ( end, " flt " );
+    end = formatInt ( end, ref_stats.faults, 0 );
+    formatLiteral ( end, " \r\n" );
     sendUART ( g_status_str );
 
     // Displays a break point to distinguish between each UART output message
-    usprintf ( g_status_str, "-------------- \r\n" );
-    sendUART ( g_status_str );
+    sendUART ( "-------------- \r\n" );
+
+    // Sizes the message for the telemetry link budget
+    setTelemetrySize ( getUARTbytesSent () - sent );
 }
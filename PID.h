@@ -7,36 +7,65 @@
 #ifndef PID_H_
 #define PID_H_
 
+#include "heli.h"
+
 //*****************************************************************************
 // Function declarations
 //*****************************************************************************
 
-// Compares two strings and returns <, ==, > 0; == 0 is equal strings
-int strcmp ( const char *str1, const char *str2 );
-
 /**
  * This function ensures that the PWM outputs are disabled when the
  * helicopter is landed, and on when the helicopter is flying/calibrating
+ * @param heli  The rig
+ */
+void
+PWMtoggle ( heli_t *heli );
+
+/**
+ * Reads the altitude, yaw and their timestamps once for the control update
+ * @param heli  The rig
+ */
+void
+sampleSensors ( heli_t *heli );
+
+/**
+ * Sends the latest main and tail outputs to the rotors in one synchronized
+ * update and records the time since the sensor readings they came from.
+ * Called after mainControl and tailControl
+ * @param heli  The rig
+ */
+void
+applyControl ( heli_t *heli );
+
+/**
+ * Starts following setpoint changes from the current targets
+ * @param heli  The rig
  */
 void
-PWMtoggle ( void );
+initControlMetrics ( heli_t *heli );
 
 /**
- * Controls helicopter height by altering the duty cycle of main PWM output
+ * Follows the response of both loops to setpoint changes. Only steps made
+ * while flying count, the take-off, calibration and landing sequences move
+ * the setpoints themselves. Called after each control update
+ * @param heli  The rig
  */
 void
-mainControl ( void );
+updateControlMetrics ( heli_t *heli );
 
 /**
- * Controls helicopter yaw by altering the duty cycle of the tail PWM output
+ * Sends a summary record for each step finished since the last call. Kept
+ * out of the control task so the UART never delays a control update
+ * @param heli  The rig
  */
 void
-tailControl ( void );
+reportControlMetrics ( heli_t *heli );
 
 /**
  * Displays PID related information to a terminal for debugging purposes
+ * @param heli  The rig
  */
 void
-UARTmessage ( void );
+UARTmessage ( heli_t *heli );
 
 #endif /* PID_H_ */
@@ -26,6 +26,8 @@
 #include "inc/hw_memmap.h"
 #include "circBufT.h"
 #include "./OrbitOLED/OrbitOLEDInterface.h"
+#include "display.h"
+#include "format.h"
 #include "utils/ustdlib.h"
 #include "buttons.h"
 #include "PWM_main.h"
@@ -46,38 +48,80 @@
  * Global variables
  **********************************************************/
 
-extern int g_duty_cycle_main = G_DUTY_CYCLE_MAIN_SIZE;
+static int g_duty_cycle_main = G_DUTY_CYCLE_MAIN_SIZE;  // Duty set by setPWMmain, percent
+static uint32_t g_main_period;                  // PWM period in ticks, set at init
 
 /**
- * Sets the PWM to a percentage (%) for the main rotor motor
+ * Sets the PWM to a percentage (%) for the main rotor motor, applied at
+ * the next period boundary
  * @param pwm   PWM value
  */
 void
 setPWMmain ( int pwm )
 {
     g_duty_cycle_main = pwm;
-    uint32_t ui32Period = SysCtlClockGet () / PWM_DIVIDER / PWM_START_RATE_HZ;
-    PWMPulseWidthSet ( PWM_MAIN_BASE, PWM_MAIN_OUTNUM, ui32Period * g_duty_cycle_main / DIVIDER );
+    setPWMmainTicks (( pwm > 0 ) ? g_main_period * pwm / DIVIDER : 0 );
+    syncPWMmain ();
 }
 
 /**
- * Returns the PWM duty cycle as a percentage (%) for the main rotor motor
+ * Applies the staged pulse width at the next period boundary of the main
+ * rotor generator
  */
-int
-getPWMmain ( void )
+void
+syncPWMmain ( void )
+{
+    PWMSyncUpdate ( PWM_MAIN_BASE, PWM_MAIN_GENBIT );
+}
+
+/**
+ * Stages the PWM pulse width in timer ticks for the main rotor motor.
+ * It takes effect at the period boundary after the next syncPWMmain
+ * @param ticks Pulse width, limited to the PWM period
+ */
+void
+setPWMmainTicks ( uint32_t ticks )
 {
-    return g_duty_cycle_main;
+    if ( ticks > g_main_period )
+    {
+        ticks = g_main_period;
+    }
+    PWMPulseWidthSet ( PWM_MAIN_BASE, PWM_MAIN_OUTNUM, ticks );
+}
+
+/**
+ * Stages the PWM duty cycle as a Q16 fraction for the main rotor motor.
+ * It takes effect at the period boundary after the next syncPWMmain
+ * @param duty  Duty cycle, PWM_Q16_ONE is 100 %
+ */
+void
+setPWMmainQ16 ( uint32_t duty )
+{
+    setPWMmainTicks (( uint32_t ) ((( uint64_t ) g_main_period * duty ) >> PWM_Q16_SHIFT ));
+}
+
+/**
+ * Returns the PWM period in timer ticks for the main rotor motor
+ * @return The PWM period
+ */
+uint32_t
+getPWMmainPeriod ( void )
+{
+    return g_main_period;
 }
 
 /**
  * Update to LED display the PWM duty cycle as a percentage (%) for main rotor
+ * @param duty  The duty cycle
  */
 void
-updateDisplayPWMmain ( void )
+updateDisplayPWMmain ( int duty )
 {
     char cMessage [ MESSAGE_SIZE ];
-    usprintf ( cMessage, "Main output: %d ", g_duty_cycle_main );
-    OLEDStringDraw ( cMessage, 0, 0 );
+    char *end = formatLiteral ( cMessage, "Main output: " );
+    end = formatInt ( end, duty, 0 );
+    formatLiteral ( end, " " );
+    displayString ( cMessage, 0, 0 );
 }
 
 /**
@@ -94,15 +138,20 @@ initPWMmain ( void )
 
     GPIOPinTypePWM ( PWM_MAIN_GPIO_BASE, PWM_MAIN_GPIO_PIN );
 
-    // Calculate the PWM period corresponding to PWM_START_RATE_HZ  .
-    uint32_t ui32Period = SysCtlClockGet () / PWM_DIVIDER / PWM_START_RATE_HZ;
+    // Calculate the PWM period corresponding to PWM_START_RATE_HZ once, the
+    // clock is not changed after initClock
+    g_main_period = SysCtlClockGet () / PWM_DIVIDER / PWM_START_RATE_HZ;
 
-    PWMGenConfigure ( PWM_MAIN_BASE, PWM_MAIN_GEN, PWM_GEN_MODE_UP_DOWN | PWM_GEN_MODE_NO_SYNC );
+    // Period and pulse width writes are buffered until a global sync, and
+    // then load at the counter zero so no runt pulses are produced
+    PWMGenConfigure ( PWM_MAIN_BASE, PWM_MAIN_GEN, PWM_GEN_MODE_UP_DOWN | PWM_GEN_MODE_SYNC | PWM_GEN_MODE_GEN_SYNC_GLOBAL );
 
-    PWMGenPeriodSet ( PWM_MAIN_BASE, PWM_MAIN_GEN, ui32Period );
+    PWMGenPeriodSet ( PWM_MAIN_BASE, PWM_MAIN_GEN, g_main_period );
 
     // Set the pulse width for PWM_START_PC % duty cycle.
-    PWMPulseWidthSet ( PWM_MAIN_BASE, PWM_MAIN_OUTNUM, ui32Period * g_duty_cycle_main / DIVIDER );
+    PWMPulseWidthSet ( PWM_MAIN_BASE, PWM_MAIN_OUTNUM, g_main_period * g_duty_cycle_main / DIVIDER );
+
+    syncPWMmain ();
 
     PWMGenEnable ( PWM_MAIN_BASE, PWM_MAIN_GEN );
 
@@ -110,5 +159,5 @@ initPWMmain ( void )
     PWMOutputState ( PWM_MAIN_BASE, PWM_MAIN_OUTBIT, false );
 
     // Updates the LED dsiplay on the Tiva board
-    updateDisplayPWMmain ();
+    updateDisplayPWMmain ( g_duty_cycle_main );
 }
@@ -7,6 +7,8 @@
 #ifndef PWM_MAIN_H_
 #define PWM_MAIN_H_
 
+#include <stdint.h>
+
 /**********************************************************
  * Defined constants
  **********************************************************/
@@ -15,6 +17,7 @@
 //  ---Main Rotor PWM: PC5, J4-05
 #define PWM_MAIN_BASE           PWM0_BASE
 #define PWM_MAIN_GEN            PWM_GEN_3
+#define PWM_MAIN_GENBIT         PWM_GEN_3_BIT
 #define PWM_MAIN_OUTNUM         PWM_OUT_7
 #define PWM_MAIN_OUTBIT         PWM_OUT_7_BIT
 #define PWM_MAIN_PERIPH_PWM     SYSCTL_PERIPH_PWM0
@@ -23,24 +26,57 @@
 #define PWM_MAIN_GPIO_CONFIG    GPIO_PC5_M0PWM7
 #define PWM_MAIN_GPIO_PIN       GPIO_PIN_5
 
+// Q16 duty cycle, shared with the other rotor
+#ifndef PWM_Q16_SHIFT
+#define PWM_Q16_SHIFT           16
+#define PWM_Q16_ONE             ( 1UL << PWM_Q16_SHIFT )       // 100 % duty
+#define PWM_Q16_PER_PERCENT     ( PWM_Q16_ONE / 100.0f )
+#endif
+
 /**
- * Sets the PWM to a percentage (%) for the main rotor motor
+ * Sets the PWM to a percentage (%) for the main rotor motor, applied at
+ * the next period boundary
  * @param pwm   PWM value
  */
 void
 setPWMmain ( int pwm );
 
 /**
- * Returns the PWM duty cycle as a percentage (%) for the main rotor motor
+ * Stages the PWM pulse width in timer ticks for the main rotor motor.
+ * It takes effect at the period boundary after the next syncPWMmain
+ * @param ticks Pulse width, limited to the PWM period
+ */
+void
+setPWMmainTicks ( uint32_t ticks );
+
+/**
+ * Stages the PWM duty cycle as a Q16 fraction for the main rotor motor.
+ * It takes effect at the period boundary after the next syncPWMmain
+ * @param duty  Duty cycle, PWM_Q16_ONE is 100 %
+ */
+void
+setPWMmainQ16 ( uint32_t duty );
+
+/**
+ * Applies the staged pulse width at the next period boundary of the main
+ * rotor generator
+ */
+void
+syncPWMmain ( void );
+
+/**
+ * Returns the PWM period in timer ticks for the main rotor motor
+ * @return The PWM period
  */
-int
-getPWMmain ( void );
+uint32_t
+getPWMmainPeriod ( void );
 
 /**
  * Update to LED display the PWM duty cycle as a percentage (%) for main rotor
+ * @param duty  The duty cycle
  */
 void
-updateDisplayPWMmain ( void );
+updateDisplayPWMmain ( int duty );
 
 /**
  * Initializes the PWM for the main rotor motor
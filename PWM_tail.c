@@ -26,6 +26,8 @@
 #include "inc/hw_memmap.h"
 #include "circBufT.h"
 #include "./OrbitOLED/OrbitOLEDInterface.h"
+#include "display.h"
+#include "format.h"
 #include "utils/ustdlib.h"
 #include "buttons.h"
 #include "PWM_tail.h"
@@ -45,38 +47,80 @@
  * Global variables
  **********************************************************/
 
-extern int g_duty_cycle_tail = 5;
+static int g_duty_cycle_tail = 5;               // Duty set by setPWMtail, percent
+static uint32_t g_tail_period;                  // PWM period in ticks, set at init
 
 /**
- * Sets the PWM to a percentage (%) for the tail rotor motor
+ * Sets the PWM to a percentage (%) for the tail rotor motor, applied at
+ * the next period boundary
  * @param pwm: The PWM value
  */
 void
 setPWMtail ( int pwm )
 {
     g_duty_cycle_tail = pwm;
-    uint32_t ui32Period = SysCtlClockGet () / PWM_DIVIDER / PWM_START_RATE_HZ;
-    PWMPulseWidthSet ( PWM_TAIL_BASE, PWM_TAIL_OUTNUM, ui32Period * g_duty_cycle_tail / DIVIDER );
+    setPWMtailTicks (( pwm > 0 ) ? g_tail_period * pwm / DIVIDER : 0 );
+    syncPWMtail ();
 }
 
 /**
- * Update to LED display the PWM duty cycle as a percentage (%) for tail rotor
+ * Applies the staged pulse width at the next period boundary of the tail
+ * rotor generator
  */
-int
-getPWMtail ( void )
+void
+syncPWMtail ( void )
 {
-    return g_duty_cycle_tail;
+    PWMSyncUpdate ( PWM_TAIL_BASE, PWM_TAIL_GENBIT );
 }
 
 /**
- * Returns the PWM duty cycle as a percentage (%) for the tail rotor motor
+ * Stages the PWM pulse width in timer ticks for the tail rotor motor.
+ * It takes effect at the period boundary after the next syncPWMtail
+ * @param ticks Pulse width, limited to the PWM period
  */
 void
-updateDisplayPWMtail ( void )
+setPWMtailTicks ( uint32_t ticks )
+{
+    if ( ticks > g_tail_period )
+    {
+        ticks = g_tail_period;
+    }
+    PWMPulseWidthSet ( PWM_TAIL_BASE, PWM_TAIL_OUTNUM, ticks );
+}
+
+/**
+ * Stages the PWM duty cycle as a Q16 fraction for the tail rotor motor.
+ * It takes effect at the period boundary after the next syncPWMtail
+ * @param duty  Duty cycle, PWM_Q16_ONE is 100 %
+ */
+void
+setPWMtailQ16 ( uint32_t duty )
+{
+    setPWMtailTicks (( uint32_t ) ((( uint64_t ) g_tail_period * duty ) >> PWM_Q16_SHIFT ));
+}
+
+/**
+ * Returns the PWM period in timer ticks for the tail rotor motor
+ * @return The PWM period
+ */
+uint32_t
+getPWMtailPeriod ( void )
+{
+    return g_tail_period;
+}
+
+/**
+ * Update to LED display the PWM duty cycle as a percentage (%) for tail rotor
+ * @param duty  The duty cycle
+ */
+void
+updateDisplayPWMtail ( int duty )
 {
     char cMessage [ MESSAGE_SIZE ];
-    usprintf ( cMessage, "Tail output: %d ", g_duty_cycle_tail );
-    OLEDStringDraw ( cMessage, 0, 1 );
+    char *end = formatLiteral ( cMessage, "Tail output: " );
+    end = formatInt ( end, duty, 0 );
+    formatLiteral ( end, " " );
+    displayString ( cMessage, 0, 1 );
 }
 
 /**
@@ -93,14 +137,19 @@ initPWMtail ( void )
 
     GPIOPinTypePWM ( PWM_TAIL_GPIO_BASE, PWM_TAIL_GPIO_PIN );
 
-    // Calculate the PWM period corresponding to PWM_START_RATE_HZ.
-    uint32_t ui32Period = SysCtlClockGet () / PWM_DIVIDER / PWM_START_RATE_HZ;
+    // Calculate the PWM period corresponding to PWM_START_RATE_HZ once, the
+    // clock is not changed after initClock
+    g_tail_period = SysCtlClockGet () / PWM_DIVIDER / PWM_START_RATE_HZ;
 
-    PWMGenConfigure ( PWM_TAIL_BASE, PWM_TAIL_GEN, PWM_GEN_MODE_UP_DOWN | PWM_GEN_MODE_NO_SYNC );
-    PWMGenPeriodSet ( PWM_TAIL_BASE, PWM_TAIL_GEN, ui32Period );
+    // Period and pulse width writes are buffered until a global sync, and
+    // then load at the counter zero so no runt pulses are produced
+    PWMGenConfigure ( PWM_TAIL_BASE, PWM_TAIL_GEN, PWM_GEN_MODE_UP_DOWN | PWM_GEN_MODE_SYNC | PWM_GEN_MODE_GEN_SYNC_GLOBAL );
+    PWMGenPeriodSet ( PWM_TAIL_BASE, PWM_TAIL_GEN, g_tail_period );
 
     // Set the pulse width for PWM_START_PC % duty cycle.
-    PWMPulseWidthSet ( PWM_TAIL_BASE, PWM_TAIL_OUTNUM, ui32Period * g_duty_cycle_tail / DIVIDER );
+    PWMPulseWidthSet ( PWM_TAIL_BASE, PWM_TAIL_OUTNUM, g_tail_period * g_duty_cycle_tail / DIVIDER );
+
+    syncPWMtail ();
 
     PWMGenEnable ( PWM_TAIL_BASE, PWM_TAIL_GEN );
 
@@ -108,5 +157,5 @@ initPWMtail ( void )
     PWMOutputState ( PWM_TAIL_BASE, PWM_TAIL_OUTBIT, false );
 
     // Updates the LED dsiplay on the Tiva board
-    updateDisplayPWMtail ();
+    updateDisplayPWMtail ( g_duty_cycle_tail );
 }
@@ -7,6 +7,8 @@
 #ifndef PWM_TAIL_H_
 #define PWM_TAIL_H_
 
+#include <stdint.h>
+
 /**********************************************************
  * Defined constants
  **********************************************************/
@@ -15,6 +17,7 @@
 //  ---Tail Rotor PWM: PF5, J3-10
 #define PWM_TAIL_BASE           PWM1_BASE
 #define PWM_TAIL_GEN            PWM_GEN_2
+#define PWM_TAIL_GENBIT         PWM_GEN_2_BIT
 #define PWM_TAIL_OUTNUM         PWM_OUT_5
 #define PWM_TAIL_OUTBIT         PWM_OUT_5_BIT
 #define PWM_TAIL_PERIPH_PWM     SYSCTL_PERIPH_PWM1
@@ -23,24 +26,57 @@
 #define PWM_TAIL_GPIO_CONFIG    GPIO_PF1_M1PWM5
 #define PWM_TAIL_GPIO_PIN       GPIO_PIN_1
 
+// Q16 duty cycle, shared with the other rotor
+#ifndef PWM_Q16_SHIFT
+#define PWM_Q16_SHIFT           16
+#define PWM_Q16_ONE             ( 1UL << PWM_Q16_SHIFT )       // 100 % duty
+#define PWM_Q16_PER_PERCENT     ( PWM_Q16_ONE / 100.0f )
+#endif
+
 /**
- * Sets the PWM to a percentage (%) for the tail rotor motor
+ * Sets the PWM to a percentage (%) for the tail rotor motor, applied at
+ * the next period boundary
  * @param pwm: The PWM value
  */
 void
 setPWMtail ( int pwm );
 
 /**
- * Returns the PWM duty cycle as a percentage (%) for the tail rotor motor
+ * Stages the PWM pulse width in timer ticks for the tail rotor motor.
+ * It takes effect at the period boundary after the next syncPWMtail
+ * @param ticks Pulse width, limited to the PWM period
+ */
+void
+setPWMtailTicks ( uint32_t ticks );
+
+/**
+ * Stages the PWM duty cycle as a Q16 fraction for the tail rotor motor.
+ * It takes effect at the period boundary after the next syncPWMtail
+ * @param duty  Duty cycle, PWM_Q16_ONE is 100 %
+ */
+void
+setPWMtailQ16 ( uint32_t duty );
+
+/**
+ * Applies the staged pulse width at the next period boundary of the tail
+ * rotor generator
+ */
+void
+syncPWMtail ( void );
+
+/**
+ * Returns the PWM period in timer ticks for the tail rotor motor
+ * @return The PWM period
  */
-int
-getPWMtail ( void );
+uint32_t
+getPWMtailPeriod ( void );
 
 /**
  * Update to LED display the PWM duty cycle as a percentage (%) for tail rotor
+ * @param duty  The duty cycle
  */
 void
-updateDisplayPWMtail ( void );
+updateDisplayPWMtail ( int duty );
 
 /**
  * Initializes the PWM for the tail rotor motor
@@ -14,10 +14,14 @@
 #include "PWM_tail.h"
 #include "UART.h"
 #include "height.h"
+#include "events.h"
+#include "memory.h"
 #include "inc/hw_memmap.h"
 #include "utils/uartstdio.h"
 #include "utils/ustdlib.h"
+#include "inc/hw_ints.h"
 #include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
 #include "driverlib/pin_map.h"
 #include "driverlib/sysctl.h"
 #include "driverlib/uart.h"
@@ -26,7 +30,12 @@
  * Defined constants
  **********************************************************/
 
-#define BAUD_RATE               9600
+#ifndef BAUD_RATE
+#define BAUD_RATE               115200  // Start-up rate, override with -DBAUD_RATE
+#endif
+#define UART_BITS_PER_BYTE      10      // Start, 8 data and stop bits
+#define TELEMETRY_SHARE         50      // Percent of the link telemetry may use
+#define TICK_RATE_HZ            80      // SysTick rate (SAMPLE_RATE_HZ in main.c)
 #define UART_USB_BASE           UART0_BASE
 #define UART_USB_PERIPH_UART    SYSCTL_PERIPH_UART0
 #define UART_USB_PERIPH_GPIO    SYSCTL_PERIPH_GPIOA
@@ -34,6 +43,48 @@
 #define UART_USB_GPIO_PIN_RX    GPIO_PIN_0
 #define UART_USB_GPIO_PIN_TX    GPIO_PIN_1
 #define UART_USB_GPIO_PINS      UART_USB_GPIO_PIN_RX | UART_USB_GPIO_PIN_TX
+#define TELEMETRY_STEP          75      // Default SysTick ticks per telemetry message
+#define MIN_TELEMETRY_STEP      1       // Fastest telemetry, one message per tick
+#define RX_BUF_SIZE             64      // Received characters held for parsing, a power of two
+
+/**********************************************************
+ * Global variables
+ **********************************************************/
+
+static uint32_t g_telemetry_step = TELEMETRY_STEP;   // Requested telemetry period
+static uint32_t g_telemetry_size = 0;                 // Bytes in the last telemetry message
+static uint32_t g_baud_rate = BAUD_RATE;
+static uint32_t g_tx_count = 0;                       // Bytes sent since power-up
+static char g_rx_buf [ RX_BUF_SIZE ];           // Received characters
+static volatile uint32_t g_rx_windex = 0;       // Written by the receive interrupt only
+static volatile uint32_t g_rx_rindex = 0;       // Read by getUARTchar only
+
+/**
+ * UART receive interrupt handler, moves received characters from the FIFO
+ * into the receive buffer. Characters are dropped when the buffer is full
+ */
+void
+UARTIntHandler ( void )
+{
+    traceEvent ( EVT_ISR_ENTER, EVT_ISR_UART, 0 );
+
+    uint32_t status = UARTIntStatus ( UART_USB_BASE, true );
+
+    UARTIntClear ( UART_USB_BASE, status );
+
+    while ( UARTCharsAvail ( UART_USB_BASE ))
+    {
+        char c = UARTCharGetNonBlocking ( UART_USB_BASE );
+
+        if ( g_rx_windex - g_rx_rindex < RX_BUF_SIZE )
+        {
+            g_rx_buf [ g_rx_windex & ( RX_BUF_SIZE - 1 ) ] = c;
+            ++g_rx_windex;
+        }
+    }
+    traceEvent ( EVT_UART_DEPTH, 0, g_rx_windex - g_rx_rindex );
+    traceEvent ( EVT_ISR_EXIT, EVT_ISR_UART, 0 );
+}
 
 /**
  * Initializes the UART
@@ -47,12 +98,37 @@ initUART ( void )
 
     // Select the alternate (UART) function for these pins.
     GPIOPinTypeUART ( UART_USB_GPIO_BASE, UART_USB_GPIO_PINS );
-    UARTConfigSetExpClk ( UART_USB_BASE, SysCtlClockGet(), BAUD_RATE,
+    UARTConfigSetExpClk ( UART_USB_BASE, SysCtlClockGet(), g_baud_rate,
                           UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE );
     UARTFIFOEnable ( UART_USB_BASE );
+
+    // Interrupt on received data and on receive timeout for partial FIFOs
+    UARTIntRegister ( UART_USB_BASE, UARTIntHandler );
+    UARTIntEnable ( UART_USB_BASE, UART_INT_RX | UART_INT_RT );
+    IntEnable ( INT_UART0 );
+
+    registerMemory ( "uart receive", sizeof ( g_rx_buf ));
+
     UARTEnable ( UART_USB_BASE );
 }
 
+/**
+ * Takes the next received character, if any
+ * @param c     Destination for the character
+ * @return      True if a character was taken
+ */
+bool
+getUARTchar ( char *c )
+{
+    if ( g_rx_rindex == g_rx_windex )
+    {
+        return false;
+    }
+    *c = g_rx_buf [ g_rx_rindex & ( RX_BUF_SIZE - 1 ) ];
+    ++g_rx_rindex;
+    return true;
+}
+
 /**
  * Sends the UART
  * @param *pucBuffer
@@ -66,5 +142,122 @@ sendUART ( char *pucBuffer )
         // Write the next character to the UART Tx FIFO.
         UARTCharPut ( UART0_BASE, *pucBuffer );
         ++pucBuffer;
+        ++g_tx_count;
+    }
+}
+
+/**
+ * Sends a block of binary data over the UART
+ * @param data      The bytes to send
+ * @param length    Number of bytes
+ */
+void
+sendUARTbytes ( const uint8_t *data, uint32_t length )
+{
+    while ( length-- )
+    {
+        UARTCharPut ( UART0_BASE, *data++ );
+        ++g_tx_count;
+    }
+}
+
+/**
+ * Changes the baud rate once everything queued has been sent
+ * @param baud  The new baud rate, MIN_BAUD_RATE to MAX_BAUD_RATE
+ * @return      True if the rate was changed
+ */
+bool
+setBaudRate ( uint32_t baud )
+{
+    if ( baud < MIN_BAUD_RATE || baud > MAX_BAUD_RATE )
+    {
+        return false;
+    }
+
+    while ( UARTBusy ( UART_USB_BASE ))
+    {
+        continue;
     }
+    UARTDisable ( UART_USB_BASE );
+    UARTConfigSetExpClk ( UART_USB_BASE, SysCtlClockGet (), baud,
+                          UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE );
+    UARTEnable ( UART_USB_BASE );
+    g_baud_rate = baud;
+    return true;
+}
+
+/**
+ * Returns the current baud rate
+ * @return The baud rate
+ */
+uint32_t
+getBaudRate ( void )
+{
+    return g_baud_rate;
+}
+
+/**
+ * Returns the number of bytes sent since power-up
+ * @return The bytes sent
+ */
+uint32_t
+getUARTbytesSent ( void )
+{
+    return g_tx_count;
+}
+
+/**
+ * Records the size of the last telemetry message for the link budget
+ * @param bytes The telemetry message size
+ */
+void
+setTelemetrySize ( uint32_t bytes )
+{
+    g_telemetry_size = bytes;
+}
+
+/**
+ * Sets the number of SysTick ticks between telemetry messages
+ * @param step  The telemetry period in ticks
+ */
+void
+setTelemetryStep ( uint32_t step )
+{
+    g_telemetry_step = ( step < MIN_TELEMETRY_STEP ) ? MIN_TELEMETRY_STEP : step;
+}
+
+/**
+ * Returns the telemetry share of the link at a baud rate
+ * @param baud  The baud rate
+ * @return      The telemetry budget in bytes per second
+ */
+uint32_t
+getTelemetryBudgetAt ( uint32_t baud )
+{
+    return baud / UART_BITS_PER_BYTE * TELEMETRY_SHARE / 100;
+}
+
+/**
+ * Returns the telemetry share of the link at the current baud rate
+ * @return The telemetry budget in bytes per second
+ */
+uint32_t
+getTelemetryBudget ( void )
+{
+    return getTelemetryBudgetAt ( g_baud_rate );
+}
+
+/**
+ * Returns the number of SysTick ticks between telemetry messages. This is
+ * the requested period, lengthened if needed so telemetry stays within
+ * TELEMETRY_SHARE of the link at the current baud rate
+ * @return The telemetry period in ticks
+ */
+uint32_t
+getTelemetryStep ( void )
+{
+    uint32_t budget = getTelemetryBudget ();
+    uint32_t min_step = ( g_telemetry_size * TICK_RATE_HZ + budget - 1 ) / budget;
+
+    return ( g_telemetry_step > min_step ) ? g_telemetry_step : min_step;
 }
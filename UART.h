@@ -7,16 +7,102 @@
 #ifndef UART_H_
 #define UART_H_
 
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define MIN_BAUD_RATE           9600
+#define MAX_BAUD_RATE           1000000 // Fastest rate of the ICDI USB bridge
+
 /**
  * Initializes the UART
  */
 void
 initUART ( void );
 
+/**
+ * Takes the next received character, if any
+ * @param c     Destination for the character
+ * @return      True if a character was taken
+ */
+bool
+getUARTchar ( char *c );
+
 /**
  * sends the UART
  */
 void
 sendUART ( char *stringBuffer );
 
+/**
+ * Sends a block of binary data over the UART
+ * @param data      The bytes to send
+ * @param length    Number of bytes
+ */
+void
+sendUARTbytes ( const uint8_t *data, uint32_t length );
+
+/**
+ * Changes the baud rate once everything queued has been sent
+ * @param baud  The new baud rate, MIN_BAUD_RATE to MAX_BAUD_RATE
+ * @return      True if the rate was changed
+ */
+bool
+setBaudRate ( uint32_t baud );
+
+/**
+ * Returns the current baud rate
+ * @return The baud rate
+ */
+uint32_t
+getBaudRate ( void );
+
+/**
+ * Returns the number of bytes sent since power-up
+ * @return The bytes sent
+ */
+uint32_t
+getUARTbytesSent ( void );
+
+/**
+ * Records the size of the last telemetry message for the link budget
+ * @param bytes The telemetry message size
+ */
+void
+setTelemetrySize ( uint32_t bytes );
+
+/**
+ * Sets the number of SysTick ticks between telemetry messages
+ * @param step  The telemetry period in ticks
+ */
+void
+setTelemetryStep ( uint32_t step );
+
+/**
+ * Returns the telemetry share of the link at a baud rate
+ * @param baud  The baud rate
+ * @return      The telemetry budget in bytes per second
+ */
+uint32_t
+getTelemetryBudgetAt ( uint32_t baud );
+
+/**
+ * Returns the telemetry share of the link at the current baud rate
+ * @return The telemetry budget in bytes per second
+ */
+uint32_t
+getTelemetryBudget ( void );
+
+/**
+ * Returns the number of SysTick ticks between telemetry messages. This is
+ * the requested period, lengthened if needed so telemetry stays within
+ * TELEMETRY_SHARE of the link at the current baud rate
+ * @return The telemetry period in ticks
+ */
+uint32_t
+getTelemetryStep ( void );
+
 #endif /* UART_H_ */
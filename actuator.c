@@ -0,0 +1,94 @@
+/* @file    actuator.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Applies the shaped control outputs to the rotor PWMs
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "inc/hw_memmap.h"
+#include "driverlib/pwm.h"
+#include "driverlib/interrupt.h"
+#include "PWM_main.h"
+#include "PWM_tail.h"
+#include "actuator.h"
+
+/**********************************************************
+ * Global variables
+ **********************************************************/
+
+static actuatorShape_t g_shape [ NUM_ACTUATORS ];    // Shaping per channel
+static uint32_t g_output [ NUM_ACTUATORS ];     // Last shaped duty per channel
+
+/**
+ * Loads the default shaping of both channels
+ */
+void
+initActuator ( void )
+{
+    g_shape [ ACTUATOR_MAIN ] = *getDefaultShape ( ACTUATOR_MAIN );
+    g_shape [ ACTUATOR_TAIL ] = *getDefaultShape ( ACTUATOR_TAIL );
+}
+
+/**
+ * Sets the shaping for one actuator channel
+ * @param channel   ACTUATOR_MAIN or ACTUATOR_TAIL
+ * @param shape     The new shaping
+ */
+void
+setActuatorShape ( uint8_t channel, const actuatorShape_t *shape )
+{
+    if ( channel < NUM_ACTUATORS )
+    {
+        g_shape [ channel ] = *shape;
+    }
+}
+
+/**
+ * Returns the shaping for one actuator channel
+ * @param channel   ACTUATOR_MAIN or ACTUATOR_TAIL
+ * @return          The channel shaping
+ */
+const actuatorShape_t *
+getActuatorShape ( uint8_t channel )
+{
+    return &g_shape [ channel < NUM_ACTUATORS ? channel : ACTUATOR_MAIN ];
+}
+
+/**
+ * Returns the duty cycle last sent to one actuator channel
+ * @param channel   ACTUATOR_MAIN or ACTUATOR_TAIL
+ * @return          The shaped duty cycle, Q16
+ */
+uint32_t
+getActuatorOutput ( uint8_t channel )
+{
+    return ( channel < NUM_ACTUATORS ) ? g_output [ channel ] : 0;
+}
+
+/**
+ * Shapes and applies new main and tail commands together. Both take effect
+ * on the next period boundary of their generators, never mid-period
+ * @param main_duty Main rotor command, Q16 (PWM_Q16_ONE is 100 %)
+ * @param tail_duty Tail rotor command, Q16 (PWM_Q16_ONE is 100 %)
+ */
+void
+applyActuatorCommand ( uint32_t main_duty, uint32_t tail_duty )
+{
+    // Stages both pulse widths, neither is used until its generator syncs
+    g_output [ ACTUATOR_MAIN ] = shapeCommand ( &g_shape [ ACTUATOR_MAIN ], g_output [ ACTUATOR_MAIN ], main_duty );
+    g_output [ ACTUATOR_TAIL ] = shapeCommand ( &g_shape [ ACTUATOR_TAIL ], g_output [ ACTUATOR_TAIL ], tail_duty );
+    setPWMmainQ16 ( g_output [ ACTUATOR_MAIN ] );
+    setPWMtailQ16 ( g_output [ ACTUATOR_TAIL ] );
+
+    // The rotors are on separate PWM modules, so the two global syncs are
+    // issued back to back with interrupts masked to keep them together
+    bool masked = IntMasterDisable ();
+    syncPWMmain ();
+    syncPWMtail ();
+
+    if ( !masked )
+    {
+        IntMasterEnable ();
+    }
+}
@@ -0,0 +1,56 @@
+/* @file    actuator.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Header file for the rotor actuator command
+ */
+
+#ifndef ACTUATOR_H_
+#define ACTUATOR_H_
+
+#include <stdint.h>
+#include "shape.h"
+
+//*****************************************************************************
+// Function declarations
+//*****************************************************************************
+
+/**
+ * Loads the default shaping of both channels
+ */
+void
+initActuator ( void );
+
+/**
+ * Sets the shaping for one actuator channel
+ * @param channel   ACTUATOR_MAIN or ACTUATOR_TAIL
+ * @param shape     The new shaping
+ */
+void
+setActuatorShape ( uint8_t channel, const actuatorShape_t *shape );
+
+/**
+ * Returns the shaping for one actuator channel
+ * @param channel   ACTUATOR_MAIN or ACTUATOR_TAIL
+ * @return          The channel shaping
+ */
+const actuatorShape_t *
+getActuatorShape ( uint8_t channel );
+
+/**
+ * Returns the duty cycle last sent to one actuator channel
+ * @param channel   ACTUATOR_MAIN or ACTUATOR_TAIL
+ * @return          The shaped duty cycle, Q16
+ */
+uint32_t
+getActuatorOutput ( uint8_t channel );
+
+/**
+ * Shapes and applies new main and tail commands together. Both take effect
+ * on the next period boundary of their generators, never mid-period
+ * @param main_duty Main rotor command, Q16 (PWM_Q16_ONE is 100 %)
+ * @param tail_duty Tail rotor command, Q16 (PWM_Q16_ONE is 100 %)
+ */
+void
+applyActuatorCommand ( uint32_t main_duty, uint32_t tail_duty );
+
+#endif /* ACTUATOR_H_ */
@@ -24,43 +24,24 @@
 #include "height.h"
 #include "yaw.h"
 #include "UART.h"
+#include "config.h"
+#include "events.h"
 
 //*****************************************************************************
 // Defined constants
 //*****************************************************************************
 
 #define NUM_BUT_POLLS           3   // The number of button polls
-#define YAW_STEP                15  // The yaw degrees per yaw change
-#define ALT_STEP                10  // The altitude percent per altitude change
-#define CEILING_HEIGHT          100 // The ceiling (max) altitude percentage
-#define FLOOR                   0   // The floor (min) altitude percentage
-#define TRUE                    1   // 1 for true as C doesn't use true/false
-#define FALSE                   0   // 0 for false as C doesn't use true/false
-#define ERROR                   2   // Error margin for each altitude step
-#define INIT_ALT_STEP           10  // Init altitude step from ground mit error
-#define INIT_MAIN_DTY_CYCL      15  // Init for the main rotor motor duty cycle
-#define G_STATE_SIZE            20
+#define MESSAGE_SIZE            40  // Size of message for UART
 
 // *******************************************************
 // Globals to module
 // *******************************************************
 
-char g_state [ G_STATE_SIZE ] = "landed";
-
 static bool g_but_state [ NUM_BUTS ];    // Corresponds to the electrical g_state
 static bool g_but_flag [ NUM_BUTS ];
 static bool g_but_normal [ NUM_BUTS ];
-_Bool g_flying_from_landed = FALSE;
-_Bool g_start_up_sequence = TRUE;
-_Bool g_calibrate = FALSE;
-_Bool g_landing_sequence = FALSE;
-extern _Bool g_ref_found;
-
 static uint8_t g_but_count [ NUM_BUTS ];
-int8_t g_altitude_percent = 0;
-int16_t g_yaw_angle = 0;
-int8_t g_button_state;
-extern int g_duty_cycle_main;
 
 /**
  * Initializes the variables associated with the set of buttons
@@ -112,145 +93,64 @@ initButtons ( void )
 }
 
 /**
- * Handles all of the states
+ * Reads the change of every button since the last call and the yaw
+ * reference status for the flight state machine
+ * @param inputs    Destination for the inputs
  */
-void
-stateHandler ( void )
+static void
+readFlightInputs ( flightInputs_t *inputs )
 {
-    if ( g_flying_from_landed )
-    {
-        if ( !g_start_up_sequence )
-        {
-            g_button_state = checkButton ( SWITCH );
-
-            switch ( g_button_state )
-            {
-            case PUSHED:
-                strcpy ( g_state, "Flying" );
-                break;
-            case RELEASED:
-                strcpy ( g_state, "landing" );
-                g_landing_sequence = TRUE;
-                break;
-            }
-        } else
-        {
-            g_button_state = checkButton ( SWITCH );
-
-            switch ( g_button_state )
-            {
-            case PUSHED:
-                g_calibrate = TRUE;
-                break;
-            }
-        }
-    } else
-    {
-        g_button_state = checkButton ( SWITCH );
-
-        switch ( g_button_state )
-        {
-        case RELEASED:
-            g_flying_from_landed = TRUE;
-            break;
-        }
-    }
-
-    if ( g_landing_sequence )
-    {
-        if ( getAltitudePercentage () < ( INIT_ALT_STEP - ERROR ))
-        {
-            g_landing_sequence = FALSE;
-            g_altitude_percent = 0;
-            strcpy ( g_state, "landed" );
-        }
-        else
-        {
-            g_yaw_angle = 0;
-            g_altitude_percent = INIT_ALT_STEP;
-            g_duty_cycle_main = INIT_MAIN_DTY_CYCL;
-        }
-    }
+    uint8_t i;
 
-    if ( g_calibrate )
+    for ( i = 0; i < NUM_BUTS; i++ )
     {
-        strcpy ( g_state, "Calibration" );
-        g_altitude_percent = INIT_ALT_STEP * 2;   // Sets the PWM for the tail to on
-
-        if ( g_ref_found )
-        {
-            g_altitude_percent = 0;
-            g_start_up_sequence = FALSE;
-            g_calibrate = FALSE;
-            g_yaw_angle = 0;
-            sendUART ( "Yaw angle reset here" );
-            strcpy ( g_state, "Flying" );
-        } else
-        {
-            if (( getYaw () < ( g_yaw_angle + ERROR )) && ( getYaw () ) >  ( g_yaw_angle - ERROR ))
-            {
-                g_yaw_angle -= YAW_STEP;
-            }
-        }
+        inputs->buttons [ i ] = checkButton ( i );
     }
+    inputs->yaw_referenced = isYawReferenced ();
 }
 
 /**
- * Checks the state of the buttons and does something with the information
+ * Polls the buttons and moves the targets for any pushed while flying
+ * @param heli      The rig
+ * @param inputs    Destination for the button changes, passed on to stateHandler
  */
 void
-checkButState ( void )
+checkButState ( heli_t *heli, flightInputs_t *inputs )
 {
     updateButtons ();
+    readFlightInputs ( inputs );
+    updateFlightTargets ( heli, inputs );
+}
 
-    if ( strcmp ( g_state, "Flying" ) == 0 )
-    {
-        g_button_state = checkButton ( UP );
+/**
+ * Runs one flight state update and does the hardware work it asks for
+ * @param heli      The rig
+ * @param inputs    Inputs read by checkButState
+ */
+void
+stateHandler ( heli_t *heli, const flightInputs_t *inputs )
+{
+    uint8_t actions = updateFlightState ( heli, inputs );
 
-        switch ( g_button_state )
-        {
-        case PUSHED:
-            if ( g_altitude_percent < CEILING_HEIGHT )
-            {
-                g_altitude_percent += ALT_STEP;
-            }
-            break;
-        case RELEASED:
-           break;
-        }
-        g_button_state = checkButton ( DOWN );
+    if ( actions & FLIGHT_LANDED )
+    {
+        // Parked at the reference, so the next power-up can warm start
+        saveConfig ( heli );
 
-        switch ( g_button_state )
+        // Sends the edges captured at an encoder fault (YAW_TRACE builds)
+        if ( isYawFault () )
         {
-        case PUSHED:
-            if ( g_altitude_percent > FLOOR )
-            {
-                g_altitude_percent -= ALT_STEP;
-            }
-            break;
-        case RELEASED:
-            break;
+            dumpYawTrace ();
         }
-        g_button_state = checkButton ( LEFT );
+    }
 
-        switch ( g_button_state )
-        {
-        case PUSHED:
-            g_yaw_angle -= YAW_STEP;
-            break;
-        case RELEASED:
-            break;
-        }
-        g_button_state = checkButton ( RIGHT );
+    if ( actions & FLIGHT_REFERENCED )
+    {
+        char message [ MESSAGE_SIZE ];
 
-        switch ( g_button_state )
-        {
-        case PUSHED:
-            g_yaw_angle += YAW_STEP;
-            break;
-        case RELEASED:
-            break;
-        }
+        usprintf ( message, "Yaw reference at %d ticks in %d ms \r\n",
+                   ( int ) getRefTicks (), ( int ) ( heli->fsm.seek_updates * 1000 / STATE_UPDATE_HZ ));
+        sendUART ( message );
     }
 }
 
@@ -282,6 +182,7 @@ updateButtons ( void )
             {
                 g_but_state [ i ] = but_value [ i ];
                 g_but_flag [ i ] = true;
+                traceEvent ( EVT_BUTTON, i, but_value [ i ] != g_but_normal [ i ] );
                 g_but_count [ i ] = 0;
             }
         }
@@ -9,15 +9,13 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "heli.h"
+#include "flight.h"
 
 //*****************************************************************************
 // Defined constants
 //*****************************************************************************
 
-// Enumerations
-enum butNames { UP = 0, DOWN, LEFT, RIGHT, SWITCH, SWITCH_2, NUM_BUTS };
-enum butStates { RELEASED = 0, PUSHED, NO_CHANGE };
-
 // UP button
 #define UP_BUT_PERIPH           SYSCTL_PERIPH_GPIOE
 #define UP_BUT_PORT_BASE        GPIO_PORTE_BASE
@@ -58,12 +56,6 @@ enum butStates { RELEASED = 0, PUSHED, NO_CHANGE };
 // Function declarations
 //*****************************************************************************
 
-// Copies a string '*src' to string '*dest'
-char *strcpy ( char *dest, const char *src );
-
-// Compares two strings and returns <, ==, > 0; == 0 is equal strings
-int strcmp ( const char *str1, const char *str2 );
-
 /**
  * Initializes the variables associated with the set of buttons
  */
@@ -77,10 +69,12 @@ void
 controlled_landing ( void );
 
 /**
- * Checks the state of the buttons and does something with the information
+ * Polls the buttons and moves the targets for any pushed while flying
+ * @param heli      The rig
+ * @param inputs    Destination for the button changes, passed on to stateHandler
  */
 void
-checkButState ( void );
+checkButState ( heli_t *heli, flightInputs_t *inputs );
 
 /**
  * Polls all buttons once and updates variables associated with buttons if necessary
@@ -98,9 +92,11 @@ uint8_t
 checkButton ( uint8_t butName );
 
 /**
- * Handles all of the states
+ * Runs one flight state update and does the hardware work it asks for
+ * @param heli      The rig
+ * @param inputs    Inputs read by checkButState
  */
 void
-stateHandler ( void );
+stateHandler ( heli_t *heli, const flightInputs_t *inputs );
 
 #endif /* BUTTONS_H_ */
@@ -5,30 +5,27 @@
 // Support for a circular buffer of uint32_t values on the
 //  Tiva processor.
 // P.J. Bones UCECE
-// Last modified:  8.3.2017
+// Last modified:  19.10.2026
 //
 // *******************************************************
 
 #include <stdint.h>
-#include "stdlib.h"
 #include "circBufT.h"
 
 // *******************************************************
-// initCircBuf: Initialise the circBuf instance. Reset both indices to
-// the start of the buffer.  Dynamically allocate and clear the the
-// memory and return a pointer for the data.  Return NULL if
-// allocation fails.
-uint32_t *
-initCircBuf (circBuf_t *buffer, uint32_t size)
+// initCircBuf: Initialise a circBuf instance defined by
+// STATIC_CIRC_BUF. Reset both indices to the start of the buffer
+// and clear the data.
+void
+initCircBuf (circBuf_t *buffer)
 {
+    uint32_t i;
+
     buffer->windex = 0;
     buffer->rindex = 0;
-    buffer->size = size;
-    buffer->data =
-        (uint32_t *) calloc (size, sizeof(uint32_t));
-    return buffer->data;
+    for (i = 0; i < buffer->size; i++)
+        buffer->data[i] = 0;
 }
-   // Note use of calloc() to clear contents.
 
 // *******************************************************
 // writeCircBuf: insert entry at the current windex location,
@@ -57,18 +54,3 @@ readCircBuf (circBuf_t *buffer)
        buffer->rindex = 0;
     return entry;
 }
-
-// *******************************************************
-// freeCircBuf: Releases the memory allocated to the buffer data,
-// sets pointer to NULL and ohter fields to 0. The buffer can
-// re-initialised by another call to initCircBuf().
-void
-freeCircBuf (circBuf_t * buffer)
-{
-    buffer->windex = 0;
-    buffer->rindex = 0;
-    buffer->size = 0;
-    free (buffer->data);
-    buffer->data = NULL;
-}
-
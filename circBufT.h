@@ -8,7 +8,7 @@
 // Support for a circular buffer of uint32_t values on the
 //  Tiva processor.
 // P.J. Bones UCECE
-// Last modified:  7.3.2017
+// Last modified:  19.10.2026
 //
 // *******************************************************
 #include <stdint.h>
@@ -23,12 +23,24 @@ typedef struct {
 } circBuf_t;
 
 // *******************************************************
-// initCircBuf: Initialise the circBuf instance. Reset both indices to
-// the start of the buffer.  Dynamically allocate and clear the the
-// memory and return a pointer for the data.  Return NULL if
-// allocation fails.
-uint32_t *
-initCircBuf (circBuf_t *buffer, uint32_t size);
+// STATIC_CIRC_BUF: Defines a file scope circBuf instance with its
+// storage reserved statically. The size must be a compile time
+// constant greater than zero, so a buffer can never fail to exist.
+#define STATIC_CIRC_BUF(name, entries) \
+    typedef char name##_size_check[((entries) > 0) ? 1 : -1]; \
+    static uint32_t name##_data[(entries)]; \
+    static circBuf_t name = { (entries), 0, 0, name##_data }
+
+// *******************************************************
+// CIRC_BUF_BYTES: Bytes of storage a STATIC_CIRC_BUF reserves.
+#define CIRC_BUF_BYTES(name) (sizeof (name##_data))
+
+// *******************************************************
+// initCircBuf: Initialise a circBuf instance defined by
+// STATIC_CIRC_BUF. Reset both indices to the start of the buffer
+// and clear the data.
+void
+initCircBuf (circBuf_t *buffer);
 
 // *******************************************************
 // writeCircBuf: insert entry at the current windex location,
@@ -43,11 +55,4 @@ writeCircBuf (circBuf_t *buffer, uint32_t entry);
 uint32_t
 readCircBuf (circBuf_t *buffer);
 
-// *******************************************************
-// freeCircBuf: Releases the memory allocated to the buffer data,
-// sets pointer to NULL and other fields to 0. The buffer can
-// re initialised by another call to initCircBuf().
-void
-freeCircBuf (circBuf_t *buffer);
-
 #endif /*CIRCBUFT_H_*/
@@ -0,0 +1,356 @@
+/* @file    command.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Line based UART command interface for live tuning
+ */
+
+/**************************************************************
+ *    Commands, one per line, replies "OK" or "ERR":           *
+ *      alt <percent>           altitude target               *
+ *      yaw <degrees>           yaw target, within +-360      *
+ *      gain <main|tail> <p> <i> <d>                          *
+ *      filter <samples>        height filter length          *
+ *      rate <ticks>            telemetry period              *
+ *      sub <signal> <ticks>    binary telemetry, 0 stops it  *
+ *      baud <rate>             UART baud rate, after the OK  *
+ *      state                   reports the flight state      *
+ *      land                    starts the landing sequence   *
+ *      save                    stores the config, landed     *
+ *      trace                   dumps the yaw trace, landed   *
+ *      prof [clear]            dumps or clears task profile  *
+ *      lat [clear]             dumps or clears latency       *
+ *      evt [trig]              dumps or triggers event trace *
+ *      fdr                     downloads the flight recorder *
+ *      mem                     stack and buffer report       *
+ *************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "utils/ustdlib.h"
+#include "buttons.h"
+#include "height.h"
+#include "yaw.h"
+#include "PID.h"
+#include "control.h"
+#include "PWM_main.h"
+#include "PWM_tail.h"
+#include "UART.h"
+#include "config.h"
+#include "telemetry.h"
+#include "profile.h"
+#include "latency.h"
+#include "events.h"
+#include "recorder.h"
+#include "memory.h"
+#include "format.h"
+#include "command.h"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define CMD_LINE_SIZE           40      // Longest command line
+#define CMD_CHAR_BUDGET         16      // Characters read per call
+#define CMD_MAX_ARGS            5       // Words per command line
+#define MESSAGE_SIZE            64      // Size of a reply
+
+/**********************************************************
+ * Global variables
+ **********************************************************/
+
+static char g_line [ CMD_LINE_SIZE ];   // Command line being received
+static uint32_t g_line_len = 0;
+static bool g_line_overflow = false;    // Set when the line is too long
+static uint32_t g_new_baud = 0;         // Baud rate to switch to after the reply
+
+/**
+ * Splits a line into words separated by spaces, in place
+ * @param line  The line
+ * @param args  Destination for the word pointers
+ * @return      Number of words
+ */
+static uint32_t
+splitLine ( char *line, char *args [ CMD_MAX_ARGS ] )
+{
+    uint32_t count = 0;
+
+    while ( *line && count < CMD_MAX_ARGS )
+    {
+        while ( *line == ' ' )
+        {
+            *line++ = '\0';
+        }
+
+        if ( *line )
+        {
+            args [ count++ ] = line;
+        }
+
+        while ( *line && *line != ' ' )
+        {
+            ++line;
+        }
+    }
+    return count;
+}
+
+/**
+ * Parses a whole word as a signed decimal
+ * @param word  The word
+ * @param value Destination for the value
+ * @return      True if the whole word was a number
+ */
+static bool
+parseInt ( const char *word, int32_t *value )
+{
+    const char *end;
+
+    *value = ( int32_t ) ustrtoul ( word, &end, 10 );
+    return end != word && *end == '\0';
+}
+
+/**
+ * Parses a whole word as a decimal float
+ * @param word  The word
+ * @param value Destination for the value
+ * @return      True if the whole word was a number
+ */
+static bool
+parseFloat ( const char *word, float *value )
+{
+    const char *end;
+
+    *value = ustrtof ( word, &end );
+    return end != word && *end == '\0';
+}
+
+/**
+ * Sends the flight state, current altitude, yaw and duty cycles
+ * @param heli  The rig
+ */
+static void
+sendState ( const heli_t *heli )
+{
+    char message [ MESSAGE_SIZE ];
+    char *end = formatLiteral ( message, "state " );
+
+    end = formatString ( end, getState ( heli ));
+    end = formatLiteral ( end, " alt " );
+    end = formatInt ( end, getAltitudePercentage (), 0 );
+    end = formatLiteral ( end, " yaw " );
+    end = formatInt ( end, getYaw (), 0 );
+    end = formatLiteral ( end, " main " );
+    end = formatInt ( end, heli->actuators.main_duty, 0 );
+    end = formatLiteral ( end, " tail " );
+    end = formatInt ( end, heli->actuators.tail_duty, 0 );
+    formatLiteral ( end, "\r\n" );
+    sendUART ( message );
+}
+
+/**
+ * Runs one command line
+ * @param heli  The rig
+ * @param line  The command line, modified in place
+ * @return      True if the command was valid and applied
+ */
+static bool
+runCommand ( heli_t *heli, char *line )
+{
+    char *args [ CMD_MAX_ARGS ];
+    uint32_t count = splitLine ( line, args );
+    int32_t value;
+
+    if ( count == 0 )
+    {
+        return false;
+    }
+
+    if ( ustrcmp ( args [ 0 ], "alt" ) == 0 && count == 2 && parseInt ( args [ 1 ], &value ))
+    {
+        return setAltitudeTarget ( heli, value );
+    }
+
+    if ( ustrcmp ( args [ 0 ], "yaw" ) == 0 && count == 2 && parseInt ( args [ 1 ], &value ))
+    {
+        return setYawTarget ( heli, value );
+    }
+
+    if ( ustrcmp ( args [ 0 ], "gain" ) == 0 && count == 5 )
+    {
+        gains_t gains;
+
+        if ( !parseFloat ( args [ 2 ], &gains.proportional ) || !parseFloat ( args [ 3 ], &gains.integral )
+                || !parseFloat ( args [ 4 ], &gains.differential ))
+        {
+            return false;
+        }
+
+        if ( ustrcmp ( args [ 1 ], "main" ) == 0 )
+        {
+            return setGains ( &heli->main_pid, gains );
+        }
+
+        if ( ustrcmp ( args [ 1 ], "tail" ) == 0 )
+        {
+            return setGains ( &heli->tail_pid, gains );
+        }
+        return false;
+    }
+
+    if ( ustrcmp ( args [ 0 ], "filter" ) == 0 && count == 2 && parseInt ( args [ 1 ], &value ) && value > 0 )
+    {
+        setFilterLength ( value );
+        return true;
+    }
+
+    if ( ustrcmp ( args [ 0 ], "rate" ) == 0 && count == 2 && parseInt ( args [ 1 ], &value ) && value > 0 )
+    {
+        setTelemetryStep ( value );
+        return true;
+    }
+
+    if ( ustrcmp ( args [ 0 ], "sub" ) == 0 && count == 3 && parseInt ( args [ 2 ], &value ) && value >= 0 )
+    {
+        return setTelemetryRate ( findTelemetrySignal ( args [ 1 ] ), value );
+    }
+
+    // The subscriptions must still fit the link at the new rate, as the
+    // frames go out with blocking writes from the control task
+    if ( ustrcmp ( args [ 0 ], "baud" ) == 0 && count == 2 && parseInt ( args [ 1 ], &value )
+            && value >= MIN_BAUD_RATE && value <= MAX_BAUD_RATE )
+    {
+        if ( getTelemetryLoad () > getTelemetryBudgetAt ( value ))
+        {
+            return false;
+        }
+        g_new_baud = value;
+        return true;
+    }
+
+    if ( ustrcmp ( args [ 0 ], "state" ) == 0 && count == 1 )
+    {
+        sendState ( heli );
+        return true;
+    }
+
+    if ( ustrcmp ( args [ 0 ], "land" ) == 0 && count == 1 )
+    {
+        return requestLanding ( heli );
+    }
+
+    // The yaw offset is only trusted once landed at the reference, as
+    // stateHandler saves it
+    if ( ustrcmp ( args [ 0 ], "save" ) == 0 && count == 1 )
+    {
+        if ( heli->fsm.state != STATE_LANDED || !isYawReferenced ())
+        {
+            return false;
+        }
+        saveConfig ( heli );
+        return true;
+    }
+
+    // The dump holds the main loop until it is sent
+    if ( ustrcmp ( args [ 0 ], "trace" ) == 0 && count == 1 )
+    {
+        if ( heli->fsm.state != STATE_LANDED )
+        {
+            return false;
+        }
+        dumpYawTrace ();
+        return true;
+    }
+
+    if ( ustrcmp ( args [ 0 ], "prof" ) == 0 && count == 1 )
+    {
+        dumpProfile ();
+        return true;
+    }
+
+    if ( ustrcmp ( args [ 0 ], "prof" ) == 0 && count == 2 && ustrcmp ( args [ 1 ], "clear" ) == 0 )
+    {
+        clearProfile ();
+        return true;
+    }
+
+    if ( ustrcmp ( args [ 0 ], "lat" ) == 0 && count == 1 )
+    {
+        dumpLatency ();
+        return true;
+    }
+
+    if ( ustrcmp ( args [ 0 ], "lat" ) == 0 && count == 2 && ustrcmp ( args [ 1 ], "clear" ) == 0 )
+    {
+        clearLatency ();
+        return true;
+    }
+
+    // The dump holds the main loop until it is sent
+    if ( ustrcmp ( args [ 0 ], "evt" ) == 0 && count == 1 )
+    {
+        if ( heli->fsm.state != STATE_LANDED )
+        {
+            return false;
+        }
+        dumpEvents ();
+        return true;
+    }
+
+    if ( ustrcmp ( args [ 0 ], "evt" ) == 0 && count == 2 && ustrcmp ( args [ 1 ], "trig" ) == 0 )
+    {
+        triggerEvents ();
+        return true;
+    }
+
+    if ( ustrcmp ( args [ 0 ], "fdr" ) == 0 && count == 1 )
+    {
+        return dumpRecorder ( heli );
+    }
+
+    if ( ustrcmp ( args [ 0 ], "mem" ) == 0 && count == 1 )
+    {
+        dumpMemory ();
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Reads received characters and runs at most one complete command line.
+ * Bounded per call so it can run every main loop pass
+ * @param heli  The rig the commands apply to
+ */
+void
+processCommands ( heli_t *heli )
+{
+    uint32_t budget = CMD_CHAR_BUDGET;
+    char c;
+
+    while ( budget-- && getUARTchar ( &c ))
+    {
+        if ( c == '\r' || c == '\n' )
+        {
+            if ( g_line_len > 0 || g_line_overflow )
+            {
+                g_line [ g_line_len ] = '\0';
+                sendUART (( !g_line_overflow && runCommand ( heli, g_line )) ? "OK\r\n" : "ERR\r\n" );
+
+                // The reply goes out at the old rate before switching
+                if ( g_new_baud )
+                {
+                    setBaudRate ( g_new_baud );
+                    g_new_baud = 0;
+                }
+                g_line_len = 0;
+                g_line_overflow = false;
+                return;
+            }
+        } else if ( g_line_len < CMD_LINE_SIZE - 1 )
+        {
+            g_line [ g_line_len++ ] = c;
+        } else
+        {
+            g_line_overflow = true;
+        }
+    }
+}
@@ -0,0 +1,20 @@
+/* @file    command.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Header file for the UART command interface
+ */
+
+#ifndef COMMAND_H_
+#define COMMAND_H_
+
+#include "heli.h"
+
+/**
+ * Reads received characters and runs at most one complete command line.
+ * Bounded per call so it can run every main loop pass
+ * @param heli  The rig the commands apply to
+ */
+void
+processCommands ( heli_t *heli );
+
+#endif /* COMMAND_H_ */
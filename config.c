@@ -0,0 +1,196 @@
+/* @file    config.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Persistent calibration and gain record in the on-chip EEPROM
+ */
+
+/**************************************************************
+ *    Define CONFIG_RAM_EEPROM to keep the record in RAM       *
+ *    instead of the EEPROM peripheral (host builds)          *
+ *************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "string.h"
+#include "inc/hw_memmap.h"
+#include "driverlib/sysctl.h"
+#ifndef CONFIG_RAM_EEPROM
+#include "driverlib/eeprom.h"
+#endif
+#include "height.h"
+#include "yaw.h"
+#include "PID.h"
+#include "UART.h"
+#include "config.h"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define CONFIG_ADDRESS          0x0000      // EEPROM byte address of the record
+#define CONFIG_MAGIC            0x48454C49  // "HELI"
+#define CONFIG_VERSION          1           // Bump when config_t changes
+#define CRC_POLYNOMIAL          0xEDB88320  // Reflected CRC-32
+#define RAM_EEPROM_WORDS        32          // Size of the RAM stand-in
+
+/**********************************************************
+ * Type definitions
+ **********************************************************/
+
+// Stored record, all fields are 32-bit so the size is whole EEPROM words
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t length;
+    int32_t ground_height;      // Ground height in millivolts
+    float yaw_offset;           // Yaw relative to the reference when parked
+    gains_t main_gains;
+    gains_t tail_gains;
+    uint32_t filter_length;     // Samples averaged for the height
+    uint32_t telemetry_step;    // SysTick ticks per telemetry message
+    uint32_t crc;               // CRC-32 of all preceding fields
+} config_t;
+
+/**********************************************************
+ * Global variables
+ **********************************************************/
+
+#ifdef CONFIG_RAM_EEPROM
+static uint32_t g_ram_eeprom [ RAM_EEPROM_WORDS ];
+#endif
+
+/**
+ * Reads words from the EEPROM
+ * @param data      Destination for the words
+ * @param address   EEPROM byte address
+ * @param count     Number of bytes, a multiple of four
+ */
+static void
+readEEPROM ( uint32_t *data, uint32_t address, uint32_t count )
+{
+#ifdef CONFIG_RAM_EEPROM
+    memcpy ( data, ( uint8_t * ) g_ram_eeprom + address, count );
+#else
+    EEPROMRead ( data, address, count );
+#endif
+}
+
+/**
+ * Programs words into the EEPROM
+ * @param data      Source of the words
+ * @param address   EEPROM byte address
+ * @param count     Number of bytes, a multiple of four
+ */
+static void
+writeEEPROM ( uint32_t *data, uint32_t address, uint32_t count )
+{
+#ifdef CONFIG_RAM_EEPROM
+    memcpy (( uint8_t * ) g_ram_eeprom + address, data, count );
+#else
+    EEPROMProgram ( data, address, count );
+#endif
+}
+
+/**
+ * Calculates the CRC-32 of a block of bytes
+ * @param data      The bytes
+ * @param length    Number of bytes
+ * @return          The CRC-32
+ */
+static uint32_t
+calculateCRC ( const uint8_t *data, uint32_t length )
+{
+    uint32_t crc = 0xFFFFFFFF;
+    int bit;
+
+    while ( length-- )
+    {
+        crc ^= *data++;
+
+        for ( bit = 0; bit < 8; bit++ )
+        {
+            crc = ( crc >> 1 ) ^ ( CRC_POLYNOMIAL & -( crc & 1 ));
+        }
+    }
+    return ~crc;
+}
+
+/**
+ * Initializes the EEPROM holding the configuration record
+ */
+void
+initConfig ( void )
+{
+#ifndef CONFIG_RAM_EEPROM
+    SysCtlPeripheralEnable ( SYSCTL_PERIPH_EEPROM0 );
+
+    while ( !SysCtlPeripheralReady ( SYSCTL_PERIPH_EEPROM0 ))
+    {
+        continue;
+    }
+    EEPROMInit ();
+#endif
+}
+
+/**
+ * Loads the configuration record and applies it to the height, yaw, PID
+ * and telemetry modules. Nothing is applied if the record is invalid
+ * @param heli  The rig receiving the stored gains
+ * @return      True if a valid record was loaded and calibration can be skipped
+ */
+bool
+loadConfig ( heli_t *heli )
+{
+    config_t config;
+
+    readEEPROM (( uint32_t * ) &config, CONFIG_ADDRESS, sizeof ( config ));
+
+    if ( config.magic != CONFIG_MAGIC || config.version != CONFIG_VERSION
+            || config.length != sizeof ( config )
+            || config.crc != calculateCRC (( uint8_t * ) &config, sizeof ( config ) - sizeof ( config.crc )))
+    {
+        return false;
+    }
+    setGround ( config.ground_height );
+    restoreYawReference ( config.yaw_offset );
+    heli->main_pid.gains = config.main_gains;
+    heli->tail_pid.gains = config.tail_gains;
+    setFilterLength ( config.filter_length );
+    setTelemetryStep ( config.telemetry_step );
+    return true;
+}
+
+/**
+ * Stores the current ground height, yaw, gains, filter length and
+ * telemetry rate as the configuration record
+ * @param heli  The rig whose gains are stored
+ */
+void
+saveConfig ( const heli_t *heli )
+{
+    config_t config;
+
+    config.magic = CONFIG_MAGIC;
+    config.version = CONFIG_VERSION;
+    config.length = sizeof ( config );
+    config.ground_height = getGround ();
+    config.yaw_offset = getYaw ();
+    config.main_gains = heli->main_pid.gains;
+    config.tail_gains = heli->tail_pid.gains;
+    config.filter_length = getFilterLength ();
+    config.telemetry_step = getTelemetryStep ();
+    config.crc = calculateCRC (( uint8_t * ) &config, sizeof ( config ) - sizeof ( config.crc ));
+
+    writeEEPROM (( uint32_t * ) &config, CONFIG_ADDRESS, sizeof ( config ));
+}
+
+/**
+ * Invalidates the stored record so the next power-up re-calibrates
+ */
+void
+clearConfig ( void )
+{
+    uint32_t blank = 0;
+
+    writeEEPROM ( &blank, CONFIG_ADDRESS, sizeof ( blank ));
+}
@@ -0,0 +1,43 @@
+/* @file    config.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Header file for the persistent configuration record
+ */
+
+#ifndef CONFIG_H_
+#define CONFIG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "heli.h"
+
+/**
+ * Initializes the EEPROM holding the configuration record
+ */
+void
+initConfig ( void );
+
+/**
+ * Loads the configuration record and applies it to the height, yaw, PID
+ * and telemetry modules. Nothing is applied if the record is invalid
+ * @param heli  The rig receiving the stored gains
+ * @return      True if a valid record was loaded and calibration can be skipped
+ */
+bool
+loadConfig ( heli_t *heli );
+
+/**
+ * Stores the current ground height, yaw, gains, filter length and
+ * telemetry rate as the configuration record
+ * @param heli  The rig whose gains are stored
+ */
+void
+saveConfig ( const heli_t *heli );
+
+/**
+ * Invalidates the stored record so the next power-up re-calibrates
+ */
+void
+clearConfig ( void );
+
+#endif /* CONFIG_H_ */
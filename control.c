@@ -0,0 +1,178 @@
+/* @file    control.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Altitude and yaw PID control laws. They read and write only the
+ *          rig context passed in, with no hardware access or module state,
+ *          so any number of rigs can be controlled side by side and the
+ *          same code runs against a simulated plant
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "PWM_main.h"
+#include "control.h"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define MAIN_PROPORTIONAL_GAIN  0.8
+#define MAIN_INTEGRAL_GAIN      0.01
+#define MAIN_DIFFERENTIAL_GAIN  0.01
+#define TAIL_PROPORTIONAL_GAIN  0.8
+#define TAIL_INTEGRAL_GAIN      0.01
+#define TAIL_DIFFERENTIAL_GAIN  0       // Can be adjusted for tail gain
+#define MIN_CYCL_RNG            5       // Minimum control duty cycle
+#define MAX_CYCL_RNG            95      // Maximum control duty cycle
+#define MIN_DTY_CYCL            0       // Minimum duty cycle
+#define MAX_DTY_CYCL            98      // Maximum duty cycle
+#define MAIN_OFFSET             10
+#define TAIL_STABALIZER         0.85    // Stabilizes and centers helicopter
+#define MAX_GAIN                10.0f   // Largest gain taken from setGains
+
+/**
+ * Sets the default gains and clears both PID loops and outputs
+ * @param heli  The rig
+ */
+void
+initControl ( heli_t *heli )
+{
+    static const pidState_t main_pid = { .gains = { MAIN_PROPORTIONAL_GAIN, MAIN_INTEGRAL_GAIN, MAIN_DIFFERENTIAL_GAIN } };
+    static const pidState_t tail_pid = { .gains = { TAIL_PROPORTIONAL_GAIN, TAIL_INTEGRAL_GAIN, TAIL_DIFFERENTIAL_GAIN } };
+    static const actuators_t actuators = { 0 };
+
+    heli->main_pid = main_pid;
+    heli->tail_pid = tail_pid;
+    heli->actuators = actuators;
+}
+
+/**
+ * Returns a gain limited to 0 .. MAX_GAIN
+ * @param gain  The gain
+ * @return      The limited gain
+ */
+static float
+limitGain ( float gain )
+{
+    return ( gain > MAX_GAIN ) ? MAX_GAIN : gain;
+}
+
+/**
+ * Sets the gains of one PID loop, each limited to MAX_GAIN. Negative gains
+ * would drive the loop away from its setpoint and are refused
+ * @param pid       The loop
+ * @param gains     The new gains
+ * @return          True if the gains were set
+ */
+bool
+setGains ( pidState_t *pid, gains_t gains )
+{
+    // Written so a NaN fails too
+    if ( !( gains.proportional >= 0 && gains.integral >= 0 && gains.differential >= 0 ))
+    {
+        return false;
+    }
+    pid->gains.proportional = limitGain ( gains.proportional );
+    pid->gains.integral = limitGain ( gains.integral );
+    pid->gains.differential = limitGain ( gains.differential );
+    return true;
+}
+
+/**
+ *  Controls helicopter height by altering the duty cycle of main PWM output
+ * @param heli  The rig
+ */
+void
+mainControl ( heli_t *heli )
+{
+    pidState_t *pid = &heli->main_pid;
+    actuators_t *out = &heli->actuators;
+
+    //calculates the proportional and differential errors for the height
+    float main_error = heli->setpoints.altitude - heli->sensors.altitude;
+    float main_differential_error = main_error - pid->last_error;
+    pid->last_error = main_error;
+
+    //multiplies the three error signals by their respective gains
+    pid->terms.proportional = pid->gains.proportional * main_error;
+    pid->terms.integral = pid->gains.integral * pid->integral_error;
+    pid->terms.differential = pid->gains.differential * main_differential_error;
+
+    // Combines error signals into a single control signal to send to the motor
+    float main_control = MAIN_OFFSET + pid->terms.proportional + pid->terms.integral + pid->terms.differential;
+
+    out->main_duty = main_control;
+
+
+    // Prevents integrator wind-up when calculating the integral error
+    if ( out->main_duty > MIN_CYCL_RNG && out->main_duty < MAX_CYCL_RNG )
+    {
+        pid->integral_error += main_error;
+    }
+
+    // Prevents the control signal exceeding the allowed duty cycle
+    pid->integral_error += main_error;
+
+    if ( out->main_duty < MIN_CYCL_RNG )
+    {
+        out->main_duty = MIN_DTY_CYCL;
+        main_control = MIN_DTY_CYCL;
+    }
+
+    if ( out->main_duty >= MAX_CYCL_RNG )
+    {
+        out->main_duty = MAX_DTY_CYCL;
+        main_control = MAX_DTY_CYCL;
+    }
+
+    // Keeps the full resolution output, main_duty keeps the whole percent
+    out->main_command = main_control * PWM_Q16_PER_PERCENT;
+}
+
+/**
+* Controls helicopter yaw by altering the duty cycle of the tail PWM output
+* @param heli  The rig
+*/
+void
+tailControl ( heli_t *heli )
+{
+    pidState_t *pid = &heli->tail_pid;
+    actuators_t *out = &heli->actuators;
+
+    // Calculates the proportional and differential errors
+    float tail_error = heli->setpoints.yaw - heli->sensors.yaw;
+    float tail_differential_error = tail_error - pid->last_error;
+    pid->last_error = tail_error;
+
+    // Multiplies the three error signals by their respective gains
+    pid->terms.proportional = pid->gains.proportional * tail_error;
+    pid->terms.integral = pid->gains.integral * pid->integral_error;
+    pid->terms.differential = pid->gains.differential * tail_differential_error;
+
+    // Combines error signals into a single control signal to send to the motor
+    float tail_control = out->main_duty * TAIL_STABALIZER + pid->terms.proportional + pid->terms.integral
+            + pid->terms.differential;
+
+    out->tail_duty = tail_control;
+
+    // Prevents integrator wind-up when calculating the integral error
+    if ( out->tail_duty > MIN_CYCL_RNG && out->tail_duty < MAX_CYCL_RNG )
+    {
+        pid->integral_error += tail_error;
+    }
+
+    // Prevents the control signal exceeding the allowed duty cycle
+    if ( out->tail_duty < MIN_CYCL_RNG )
+    {
+        out->tail_duty = MIN_DTY_CYCL;
+        tail_control = MIN_DTY_CYCL;
+    }
+
+    if ( out->tail_duty >= MAX_CYCL_RNG )
+    {
+        out->tail_duty = MAX_DTY_CYCL;
+        tail_control = MAX_DTY_CYCL;
+    }
+
+    out->tail_command = tail_control * PWM_Q16_PER_PERCENT;
+}
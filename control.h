@@ -0,0 +1,47 @@
+/* @file    control.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Header file for the altitude and yaw control laws
+ */
+
+#ifndef CONTROL_H_
+#define CONTROL_H_
+
+#include "heli.h"
+
+//*****************************************************************************
+// Function declarations
+//*****************************************************************************
+
+/**
+ * Sets the default gains and clears both PID loops and outputs
+ * @param heli  The rig
+ */
+void
+initControl ( heli_t *heli );
+
+/**
+ * Sets the gains of one PID loop, each limited to MAX_GAIN. Negative gains
+ * would drive the loop away from its setpoint and are refused
+ * @param pid       The loop
+ * @param gains     The new gains
+ * @return          True if the gains were set
+ */
+bool
+setGains ( pidState_t *pid, gains_t gains );
+
+/**
+ * Controls helicopter height by altering the duty cycle of main PWM output
+ * @param heli  The rig
+ */
+void
+mainControl ( heli_t *heli );
+
+/**
+ * Controls helicopter yaw by altering the duty cycle of the tail PWM output
+ * @param heli  The rig
+ */
+void
+tailControl ( heli_t *heli );
+
+#endif /* CONTROL_H_ */
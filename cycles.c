@@ -0,0 +1,19 @@
+/* @file    cycles.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Cortex-M4 DWT cycle counter used for timestamps
+ */
+
+#include <stdint.h>
+#include "cycles.h"
+
+/**
+ * Enables the DWT cycle counter
+ */
+void
+initCycles ( void )
+{
+    DEM_CR |= DEM_CR_TRCENA;
+    DWT_CYCCNT = 0;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+}
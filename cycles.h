@@ -0,0 +1,32 @@
+/* @file    cycles.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Header file for the Cortex-M4 DWT cycle counter
+ */
+
+#ifndef CYCLES_H_
+#define CYCLES_H_
+
+#include <stdint.h>
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+// Debug and trace registers (ARMv7-M architecture reference manual)
+#define DEM_CR                  ( *( volatile uint32_t * ) 0xE000EDFC )
+#define DEM_CR_TRCENA           0x01000000
+#define DWT_CTRL                ( *( volatile uint32_t * ) 0xE0001000 )
+#define DWT_CTRL_CYCCNTENA      0x00000001
+#define DWT_CYCCNT              ( *( volatile uint32_t * ) 0xE0001004 )
+
+// Reads the free running CPU cycle count, a single load so it is ISR safe
+#define getCycles()             ( DWT_CYCCNT )
+
+/**
+ * Enables the DWT cycle counter
+ */
+void
+initCycles ( void );
+
+#endif /* CYCLES_H_ */
@@ -0,0 +1,122 @@
+/* @file    display.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Shadow framebuffer for the Orbit OLED, only changes are sent
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "./OrbitOLED/OrbitOLEDInterface.h"
+#include "display.h"
+#include "memory.h"
+
+//*****************************************************************************
+// Global variables
+//*****************************************************************************
+
+static char g_shadow [ DISPLAY_ROWS ][ DISPLAY_COLS ];  // Wanted characters
+static char g_shown [ DISPLAY_ROWS ][ DISPLAY_COLS ];   // Characters on the OLED
+static bool g_shadow_init = false;
+static uint32_t g_flush_row = 0;                        // Row the next flush starts on
+
+/**
+ * Fills the shadow with blanks and marks every character as unknown, so the
+ * whole OLED is drawn on the first flush
+ */
+static void
+initShadow ( void )
+{
+    uint32_t row;
+    uint32_t col;
+
+    for ( row = 0; row < DISPLAY_ROWS; row++ )
+    {
+        for ( col = 0; col < DISPLAY_COLS; col++ )
+        {
+            g_shadow [ row ][ col ] = ' ';
+            g_shown [ row ][ col ] = '\0';
+        }
+    }
+    g_shadow_init = true;
+
+    registerMemory ( "display shadow", sizeof ( g_shadow ) + sizeof ( g_shown ));
+}
+
+/**
+ * Writes a string into the shadow framebuffer. Nothing is sent to the
+ * OLED until flushDisplay; text past the end of the row is clipped
+ * @param text  The string to write
+ * @param col   The first character column
+ * @param row   The text row
+ */
+void
+displayString ( const char *text, uint32_t col, uint32_t row )
+{
+    if ( !g_shadow_init )
+    {
+        initShadow ();
+    }
+
+    if ( row >= DISPLAY_ROWS )
+    {
+        return;
+    }
+
+    while ( *text && col < DISPLAY_COLS )
+    {
+        g_shadow [ row ][ col++ ] = *text++;
+    }
+}
+
+/**
+ * Sends characters that differ from what the OLED shows, at most budget
+ * characters per call, continuing from where the last call stopped
+ * @param budget    Maximum characters to send
+ */
+void
+flushDisplay ( uint32_t budget )
+{
+    char run [ DISPLAY_COLS + 1 ];
+    uint32_t rows;
+
+    if ( !g_shadow_init )
+    {
+        return;
+    }
+
+    for ( rows = 0; rows < DISPLAY_ROWS && budget > 0; rows++ )
+    {
+        uint32_t row = g_flush_row;
+        uint32_t col = 0;
+
+        while ( col < DISPLAY_COLS && budget > 0 )
+        {
+            // Skips characters that are already shown
+            if ( g_shadow [ row ][ col ] == g_shown [ row ][ col ] )
+            {
+                ++col;
+                continue;
+            }
+
+            // Draws the run of changed characters in one call
+            uint32_t start = col;
+            uint32_t length = 0;
+
+            while ( col < DISPLAY_COLS && length < budget && g_shadow [ row ][ col ] != g_shown [ row ][ col ] )
+            {
+                run [ length++ ] = g_shadow [ row ][ col ];
+                g_shown [ row ][ col ] = g_shadow [ row ][ col ];
+                ++col;
+            }
+            run [ length ] = '\0';
+            OLEDStringDraw ( run, start, row );
+            budget -= length;
+        }
+
+        // Stays on this row if the budget ran out part way through it
+        if ( col >= DISPLAY_COLS )
+        {
+            g_flush_row = ( g_flush_row + 1 ) % DISPLAY_ROWS;
+        }
+    }
+}
@@ -0,0 +1,37 @@
+/* @file    display.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Header file for the OLED shadow framebuffer
+ */
+
+#ifndef DISPLAY_H_
+#define DISPLAY_H_
+
+#include <stdint.h>
+
+//*****************************************************************************
+// Defined constants
+//*****************************************************************************
+
+#define DISPLAY_ROWS            4       // 8 pixel text pages on the 128x32 Orbit OLED
+#define DISPLAY_COLS            16      // 8 pixel characters per page
+
+/**
+ * Writes a string into the shadow framebuffer. Nothing is sent to the
+ * OLED until flushDisplay; text past the end of the row is clipped
+ * @param text  The string to write
+ * @param col   The first character column
+ * @param row   The text row
+ */
+void
+displayString ( const char *text, uint32_t col, uint32_t row );
+
+/**
+ * Sends characters that differ from what the OLED shows, at most budget
+ * characters per call, continuing from where the last call stopped
+ * @param budget    Maximum characters to send
+ */
+void
+flushDisplay ( uint32_t budget );
+
+#endif /* DISPLAY_H_ */
@@ -0,0 +1,133 @@
+/* @file    events.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   In-RAM ring of scheduling events: interrupt entry and exit,
+ *          main loop tasks, flight state changes, buttons and UART depth
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "UART.h"
+#include "cycles.h"
+#include "events.h"
+#include "memory.h"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define EVENT_TRACE_SIZE        512     // Events held, a power of two
+
+/**********************************************************
+ * Global variables
+ **********************************************************/
+
+#ifdef EVENT_TRACE
+static event_t g_events [ EVENT_TRACE_SIZE ];   // Ring of the most recent events
+static volatile uint32_t g_event_index = 0;     // Total events recorded
+static volatile uint32_t g_stop_index = 0;      // Event count at which a trigger freezes the ring
+static volatile bool g_armed = 0;               // Set by a trigger until the ring freezes
+static volatile bool g_frozen = 0;              // Set while the ring is held for a dump
+#endif
+
+/**
+ * Adds the trace ring to the memory report. Does nothing unless built
+ * with EVENT_TRACE
+ */
+void
+initEvents ( void )
+{
+#ifdef EVENT_TRACE
+    registerMemory ( "event trace", sizeof ( g_events ));
+#endif
+}
+
+/**
+ * Adds an event to the trace ring. Safe from any interrupt or the main loop
+ * @param type  EVT_* type
+ * @param id    Handler, task, state or button
+ * @param arg   New button state or UART depth
+ */
+void
+recordEvent ( uint8_t type, uint8_t id, uint16_t arg )
+{
+#ifdef EVENT_TRACE
+    uint32_t time = getCycles ();
+
+    // Masked for the few instructions of the write so a nested interrupt
+    // cannot claim the same slot
+    bool masked = IntMasterDisable ();
+
+    if ( !g_frozen )
+    {
+        event_t *event = &g_events [ g_event_index & ( EVENT_TRACE_SIZE - 1 ) ];
+
+        event->time = time;
+        event->type = type;
+        event->id = id;
+        event->arg = arg;
+        ++g_event_index;
+
+        if ( g_armed && g_event_index == g_stop_index )
+        {
+            g_frozen = 1;
+        }
+    }
+
+    if ( !masked )
+    {
+        IntMasterEnable ();
+    }
+#endif
+}
+
+/**
+ * Freezes the trace once half the ring has been filled after the trigger,
+ * keeping the events either side of it
+ */
+void
+triggerEvents ( void )
+{
+#ifdef EVENT_TRACE
+    if ( g_armed || g_frozen )
+    {
+        return;
+    }
+    recordEvent ( EVT_TRIGGER, 0, 0 );
+    g_stop_index = g_event_index + EVENT_TRACE_SIZE / 2;
+    g_armed = 1;
+#endif
+}
+
+/**
+ * Sends the header and every held event over UART, oldest first, then
+ * restarts tracing. Does nothing unless built with EVENT_TRACE
+ */
+void
+dumpEvents ( void )
+{
+#ifdef EVENT_TRACE
+    eventHeader_t header;
+    uint32_t first;
+    uint32_t i;
+
+    g_frozen = 1;
+    header.magic = EVENT_TRACE_MAGIC;
+    header.clock_hz = SysCtlClockGet ();
+    header.count = ( g_event_index < EVENT_TRACE_SIZE ) ? g_event_index : EVENT_TRACE_SIZE;
+    header.dropped = g_event_index - header.count;
+    first = header.dropped;
+    sendUARTbytes (( uint8_t * ) &header, sizeof ( header ));
+
+    for ( i = 0; i < header.count; i++ )
+    {
+        sendUARTbytes (( uint8_t * ) &g_events [ ( first + i ) & ( EVENT_TRACE_SIZE - 1 ) ], sizeof ( event_t ));
+    }
+
+    g_event_index = 0;
+    g_armed = 0;
+    g_frozen = 0;
+#endif
+}
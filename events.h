@@ -0,0 +1,88 @@
+/* @file    events.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Header file for the in-RAM scheduling event trace
+ */
+
+#ifndef EVENTS_H_
+#define EVENTS_H_
+
+#include <stdint.h>
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+// Event trace, built in with EVENT_TRACE and converted by tools/evtrace.c
+#define EVENT_TRACE_MAGIC       0x52545645      // "EVTR"
+
+// Event types
+enum eventTypes { EVT_ISR_ENTER = 0, EVT_ISR_EXIT, EVT_TASK_START, EVT_TASK_STOP,
+                  EVT_STATE, EVT_BUTTON, EVT_UART_DEPTH, EVT_TRIGGER, NUM_EVT_TYPES };
+
+// Interrupt handlers, the id of EVT_ISR_ENTER and EVT_ISR_EXIT
+enum eventIsrs { EVT_ISR_SYSTICK = 0, EVT_ISR_ADC, EVT_ISR_YAW, EVT_ISR_REF, EVT_ISR_UART,
+                 NUM_EVT_ISRS };
+
+// Main loop tasks, the id of EVT_TASK_START and EVT_TASK_STOP
+enum eventTasks { EVT_TASK_CONTROL = 0, EVT_TASK_BUTTONS, EVT_TASK_DISPLAY, EVT_TASK_TELEMETRY,
+                  EVT_TASK_COMMAND, EVT_TASK_FLUSH, NUM_EVT_TASKS };
+
+// Trace dump header, sent little-endian ahead of the event records
+typedef struct {
+    uint32_t magic;         // EVENT_TRACE_MAGIC
+    uint32_t clock_hz;      // CPU clock for converting timestamps
+    uint32_t count;         // Number of event_t records that follow
+    uint32_t dropped;       // Events overwritten before the dump
+} eventHeader_t;
+
+// One event, 8 bytes
+typedef struct {
+    uint32_t time;          // DWT cycle count
+    uint8_t type;           // EVT_* type
+    uint8_t id;             // Handler, task, state or button
+    uint16_t arg;           // New button state or UART depth
+} event_t;
+
+// Records an event. Built in with EVENT_TRACE, otherwise expands to nothing
+#ifdef EVENT_TRACE
+#define traceEvent( type, id, arg )     recordEvent (( type ), ( id ), ( arg ))
+#else
+#define traceEvent( type, id, arg )
+#endif
+
+/**********************************************************
+ * Function declarations
+ **********************************************************/
+
+/**
+ * Adds the trace ring to the memory report. Does nothing unless built
+ * with EVENT_TRACE
+ */
+void
+initEvents ( void );
+
+/**
+ * Adds an event to the trace ring. Safe from any interrupt or the main loop
+ * @param type  EVT_* type
+ * @param id    Handler, task, state or button
+ * @param arg   New button state or UART depth
+ */
+void
+recordEvent ( uint8_t type, uint8_t id, uint16_t arg );
+
+/**
+ * Freezes the trace once half the ring has been filled after the trigger,
+ * keeping the events either side of it
+ */
+void
+triggerEvents ( void );
+
+/**
+ * Sends the header and every held event over UART, oldest first, then
+ * restarts tracing. Does nothing unless built with EVENT_TRACE
+ */
+void
+dumpEvents ( void );
+
+#endif /* EVENTS_H_ */
@@ -0,0 +1,299 @@
+/* @file    flight.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Flight state machine. Works only on the rig context and the
+ *          inputs passed in, with no hardware access or module state, so
+ *          the same sequences run on the rig and in the simulator
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "flight.h"
+#include "events.h"
+
+//*****************************************************************************
+// Defined constants
+//*****************************************************************************
+
+#define YAW_STEP                15  // The yaw degrees per yaw change
+#define ALT_STEP                10  // The altitude percent per altitude change
+#define CEILING_HEIGHT          100 // The ceiling (max) altitude percentage
+#define FLOOR                   0   // The floor (min) altitude percentage
+#define YAW_LIMIT               360 // The furthest yaw target either side of the reference
+#define TRUE                    1   // 1 for true as C doesn't use true/false
+#define FALSE                   0   // 0 for false as C doesn't use true/false
+#define ERROR                   2   // Error margin for each altitude step
+#define INIT_ALT_STEP           10  // Init altitude step from ground mit error
+#define SEEK_STEP               2   // Yaw target advance per state update while seeking
+#define SEEK_MAX_LAG            20  // Yaw lag beyond which the seek target is held
+
+// *******************************************************
+// Globals to module
+// *******************************************************
+
+// Flight state names, indexed by enum flightStates
+static const char *const g_state_names [ NUM_STATES ] = { "landed", "Flying", "landing", "Calibration" };
+
+/**
+ * Puts the flight state machine in the landed state, waiting for the mode
+ * switch to start the calibration
+ * @param heli  The rig
+ */
+void
+initFlightState ( heli_t *heli )
+{
+    static const flightState_t fsm = { STATE_LANDED, FALSE, TRUE, FALSE, FALSE, 0 };
+    static const setpoints_t setpoints = { 0, 0 };
+
+    heli->fsm = fsm;
+    heli->setpoints = setpoints;
+}
+
+/**
+ * Changes the flight state
+ * @param heli  The rig
+ * @param state The new state
+ */
+static void
+setState ( heli_t *heli, uint8_t state )
+{
+    if ( state != heli->fsm.state )
+    {
+        traceEvent ( EVT_STATE, state, 0 );
+    }
+    heli->fsm.state = state;
+}
+
+/**
+ * Moves the altitude and yaw targets by a step for each button pushed while
+ * flying
+ * @param heli      The rig
+ * @param inputs    Button changes since the last update
+ */
+void
+updateFlightTargets ( heli_t *heli, const flightInputs_t *inputs )
+{
+    setpoints_t *setpoints = &heli->setpoints;
+
+    if ( heli->fsm.state == STATE_FLYING )
+    {
+        if ( inputs->buttons [ UP ] == PUSHED && setpoints->altitude < CEILING_HEIGHT )
+        {
+            setpoints->altitude += ALT_STEP;
+        }
+
+        if ( inputs->buttons [ DOWN ] == PUSHED && setpoints->altitude > FLOOR )
+        {
+            setpoints->altitude -= ALT_STEP;
+        }
+
+        if ( inputs->buttons [ LEFT ] == PUSHED )
+        {
+            setpoints->yaw -= YAW_STEP;
+        }
+
+        if ( inputs->buttons [ RIGHT ] == PUSHED )
+        {
+            setpoints->yaw += YAW_STEP;
+        }
+    }
+}
+
+/**
+ * Advances the flight state machine by one update: take-off on the mode
+ * switch, the yaw reference seek, flying and the landing sequence
+ * @param heli      The rig
+ * @param inputs    Mode switch change and yaw reference status
+ * @return          FLIGHT_LANDED and FLIGHT_REFERENCED flags for the caller
+ */
+uint8_t
+updateFlightState ( heli_t *heli, const flightInputs_t *inputs )
+{
+    flightState_t *fsm = &heli->fsm;
+    setpoints_t *setpoints = &heli->setpoints;
+    uint8_t button_state = inputs->buttons [ SWITCH ];
+    uint8_t actions = 0;
+
+    if ( fsm->flying_from_landed )
+    {
+        if ( !fsm->start_up_sequence )
+        {
+            switch ( button_state )
+            {
+            case PUSHED:
+                setState ( heli, STATE_FLYING );
+                break;
+            case RELEASED:
+                setState ( heli, STATE_LANDING );
+                fsm->landing_sequence = TRUE;
+                break;
+            }
+        } else
+        {
+            switch ( button_state )
+            {
+            case PUSHED:
+                fsm->calibrate = TRUE;
+                break;
+            }
+        }
+    } else
+    {
+        switch ( button_state )
+        {
+        case RELEASED:
+            fsm->flying_from_landed = TRUE;
+            break;
+        }
+    }
+
+    if ( fsm->landing_sequence )
+    {
+        if ( heli->sensors.altitude < ( INIT_ALT_STEP - ERROR ))
+        {
+            fsm->landing_sequence = FALSE;
+            setpoints->altitude = 0;
+            setState ( heli, STATE_LANDED );
+            actions |= FLIGHT_LANDED;
+        }
+        else
+        {
+            setpoints->yaw = 0;
+            setpoints->altitude = INIT_ALT_STEP;
+        }
+    }
+
+    if ( fsm->calibrate )
+    {
+        setState ( heli, STATE_CALIBRATION );
+        setpoints->altitude = INIT_ALT_STEP * 2;   // Sets the PWM for the tail to on
+
+        if ( inputs->yaw_referenced )
+        {
+            setpoints->altitude = 0;
+            fsm->start_up_sequence = FALSE;
+            fsm->calibrate = FALSE;
+            setpoints->yaw = 0;     // Backs off to the reference
+            setState ( heli, STATE_FLYING );
+            actions |= FLIGHT_REFERENCED;
+        } else
+        {
+            // Sweeps the target at a constant rate, holding it while the rig lags
+            ++fsm->seek_updates;
+
+            if ( heli->sensors.yaw - setpoints->yaw < SEEK_MAX_LAG )
+            {
+                setpoints->yaw -= SEEK_STEP;
+            }
+        }
+    }
+    return actions;
+}
+
+/**
+ * Turns the rotor outputs on while flying or calibrating, and off again
+ * once landed on the ground
+ * @param heli  The rig
+ * @return      True if heli->actuators.pwm_on changed
+ */
+bool
+updateOutputEnable ( heli_t *heli )
+{
+    uint8_t state = heli->fsm.state;
+
+    if (( state == STATE_FLYING || state == STATE_CALIBRATION ) && !heli->actuators.pwm_on )
+    {
+        heli->actuators.pwm_on = TRUE;
+        return true;
+    }
+
+    if ( state == STATE_LANDED && heli->actuators.pwm_on && heli->sensors.altitude == 0 )
+    {
+        heli->actuators.pwm_on = FALSE;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Sets the altitude target while flying, limited to the floor and ceiling
+ * @param heli      The rig
+ * @param percent   The altitude target as a percentage
+ * @return          True if the target was set
+ */
+bool
+setAltitudeTarget ( heli_t *heli, int32_t percent )
+{
+    if ( heli->fsm.state != STATE_FLYING )
+    {
+        return false;
+    }
+
+    if ( percent < FLOOR )
+    {
+        percent = FLOOR;
+    }
+
+    if ( percent > CEILING_HEIGHT )
+    {
+        percent = CEILING_HEIGHT;
+    }
+    heli->setpoints.altitude = percent;
+    return true;
+}
+
+/**
+ * Sets the yaw target while flying, limited to a turn either side of the
+ * reference
+ * @param heli      The rig
+ * @param degrees   The yaw target in degrees from the reference
+ * @return          True if the target was set
+ */
+bool
+setYawTarget ( heli_t *heli, int32_t degrees )
+{
+    if ( heli->fsm.state != STATE_FLYING )
+    {
+        return false;
+    }
+
+    if ( degrees < -YAW_LIMIT )
+    {
+        degrees = -YAW_LIMIT;
+    }
+
+    if ( degrees > YAW_LIMIT )
+    {
+        degrees = YAW_LIMIT;
+    }
+    heli->setpoints.yaw = degrees;
+    return true;
+}
+
+/**
+ * Starts the landing sequence as if the mode switch was released
+ * @param heli  The rig
+ * @return      True if the helicopter was flying
+ */
+bool
+requestLanding ( heli_t *heli )
+{
+    if ( heli->fsm.state != STATE_FLYING )
+    {
+        return false;
+    }
+    setState ( heli, STATE_LANDING );
+    heli->fsm.landing_sequence = TRUE;
+    return true;
+}
+
+/**
+ * Returns the name of the current flight state
+ * @param heli  The rig
+ * @return      The flight state
+ */
+const char *
+getState ( const heli_t *heli )
+{
+    return g_state_names [ heli->fsm.state ];
+}
@@ -0,0 +1,115 @@
+/* @file    flight.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Header file for the flight state machine
+ */
+
+#ifndef FLIGHT_H_
+#define FLIGHT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "heli.h"
+
+//*****************************************************************************
+// Defined constants
+//*****************************************************************************
+
+// Enumerations
+enum butNames { UP = 0, DOWN, LEFT, RIGHT, SWITCH, SWITCH_2, NUM_BUTS };
+enum butStates { RELEASED = 0, PUSHED, NO_CHANGE };
+enum flightStates { STATE_LANDED = 0, STATE_FLYING, STATE_LANDING, STATE_CALIBRATION, NUM_STATES };
+
+// Work left to the caller of updateFlightState, OR-ed together
+#define FLIGHT_LANDED           0x01    // Landed and parked at the reference
+#define FLIGHT_REFERENCED       0x02    // Yaw reference found, seek over
+
+#define STATE_UPDATE_HZ         20      // updateFlightState rate (80 Hz / BUTTON_TIMER_STEP)
+
+//*****************************************************************************
+// Type definitions
+//*****************************************************************************
+
+// Inputs of one flight state update. The caller reads the buttons and the
+// yaw decoder, so the state machine itself never touches the hardware
+typedef struct {
+    uint8_t buttons [ NUM_BUTS ];   // Change of each button since the last update, enum butStates
+    bool yaw_referenced;            // Set once yaw is measured from the reference
+} flightInputs_t;
+
+//*****************************************************************************
+// Function declarations
+//*****************************************************************************
+
+/**
+ * Puts the flight state machine in the landed state, waiting for the mode
+ * switch to start the calibration
+ * @param heli  The rig
+ */
+void
+initFlightState ( heli_t *heli );
+
+/**
+ * Moves the altitude and yaw targets by a step for each button pushed while
+ * flying
+ * @param heli      The rig
+ * @param inputs    Button changes since the last update
+ */
+void
+updateFlightTargets ( heli_t *heli, const flightInputs_t *inputs );
+
+/**
+ * Advances the flight state machine by one update: take-off on the mode
+ * switch, the yaw reference seek, flying and the landing sequence
+ * @param heli      The rig
+ * @param inputs    Mode switch change and yaw reference status
+ * @return          FLIGHT_LANDED and FLIGHT_REFERENCED flags for the caller
+ */
+uint8_t
+updateFlightState ( heli_t *heli, const flightInputs_t *inputs );
+
+/**
+ * Turns the rotor outputs on while flying or calibrating, and off again
+ * once landed on the ground
+ * @param heli  The rig
+ * @return      True if heli->actuators.pwm_on changed
+ */
+bool
+updateOutputEnable ( heli_t *heli );
+
+/**
+ * Sets the altitude target while flying, limited to the floor and ceiling
+ * @param heli      The rig
+ * @param percent   The altitude target as a percentage
+ * @return          True if the target was set
+ */
+bool
+setAltitudeTarget ( heli_t *heli, int32_t percent );
+
+/**
+ * Sets the yaw target while flying, limited to a turn either side of the
+ * reference
+ * @param heli      The rig
+ * @param degrees   The yaw target in degrees from the reference
+ * @return          True if the target was set
+ */
+bool
+setYawTarget ( heli_t *heli, int32_t degrees );
+
+/**
+ * Starts the landing sequence as if the mode switch was released
+ * @param heli  The rig
+ * @return      True if the helicopter was flying
+ */
+bool
+requestLanding ( heli_t *heli );
+
+/**
+ * Returns the name of the current flight state
+ * @param heli  The rig
+ * @return      The flight state
+ */
+const char *
+getState ( const heli_t *heli );
+
+#endif /* FLIGHT_H_ */
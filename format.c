@@ -0,0 +1,186 @@
+/* @file    format.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Fixed-width number formatters for display and telemetry
+ */
+
+/**************************************************************
+ *    Specialized replacements for usprintf on hot paths.     *
+ *    Digits are produced two at a time from a lookup table.  *
+ *************************************************************/
+
+#include <stdint.h>
+#include "format.h"
+
+//*****************************************************************************
+// Global variables
+//*****************************************************************************
+
+// The two ASCII digits of every value 0 .. 99
+static const char g_digit_pairs [ 200 ] = {
+    '0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+    '1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+    '2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+    '3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+    '4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+    '5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+    '6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+    '7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+    '8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+    '9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9'
+};
+
+static const uint32_t g_powers_of_ten [ 10 ] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+/**
+ * Writes the digits of an unsigned value backwards from end
+ * @param end       One past the last digit
+ * @param value     The value
+ * @param digits    Minimum number of digits, zero padded
+ * @return          Pointer to the first digit
+ */
+static char *
+writeDigits ( char *end, uint32_t value, uint32_t digits )
+{
+    char *start = end;
+
+    while ( value >= 100 )
+    {
+        uint32_t pair = ( value % 100 ) * 2;
+        value /= 100;
+        *--start = g_digit_pairs [ pair + 1 ];
+        *--start = g_digit_pairs [ pair ];
+    }
+
+    if ( value >= 10 )
+    {
+        *--start = g_digit_pairs [ value * 2 + 1 ];
+        *--start = g_digit_pairs [ value * 2 ];
+    } else
+    {
+        *--start = '0' + value;
+    }
+
+    while (( uint32_t ) ( end - start ) < digits )
+    {
+        *--start = '0';
+    }
+    return start;
+}
+
+/**
+ * Copies a field, space padded on the left to width
+ * @param dest      Destination buffer
+ * @param field     The field characters
+ * @param length    Number of field characters
+ * @param width     Minimum field width
+ * @return          Pointer to the terminating null
+ */
+static char *
+padField ( char *dest, const char *field, uint32_t length, uint32_t width )
+{
+    while ( width > length )
+    {
+        *dest++ = ' ';
+        --width;
+    }
+    return formatCopy ( dest, field, length );
+}
+
+/**
+ * Copies length characters and terminates the result. Used through
+ * formatLiteral for fixed message text
+ * @param dest      Destination buffer
+ * @param text      Characters to copy
+ * @param length    Number of characters
+ * @return          Pointer to the terminating null, for appending
+ */
+char *
+formatCopy ( char *dest, const char *text, uint32_t length )
+{
+    while ( length-- )
+    {
+        *dest++ = *text++;
+    }
+    *dest = '\0';
+    return dest;
+}
+
+/**
+ * Copies a null terminated string
+ * @param dest  Destination buffer
+ * @param text  The string
+ * @return      Pointer to the terminating null, for appending
+ */
+char *
+formatString ( char *dest, const char *text )
+{
+    while ( *text )
+    {
+        *dest++ = *text++;
+    }
+    *dest = '\0';
+    return dest;
+}
+
+/**
+ * Writes a signed decimal, right aligned and space padded to width
+ * like "%*d"
+ * @param dest  Destination buffer
+ * @param value The value
+ * @param width Minimum field width, 0 for none
+ * @return      Pointer to the terminating null, for appending
+ */
+char *
+formatInt ( char *dest, int32_t value, uint32_t width )
+{
+    char field [ FORMAT_INT_SIZE ];
+    char *end = field + sizeof ( field );
+    uint32_t magnitude = ( value < 0 ) ? -( uint32_t ) value : ( uint32_t ) value;
+    char *start = writeDigits ( end, magnitude, 1 );
+
+    if ( value < 0 )
+    {
+        *--start = '-';
+    }
+    return padField ( dest, start, end - start, width );
+}
+
+/**
+ * Writes a fixed point decimal, right aligned and space padded to width.
+ * formatFixed ( dest, -1234, 2, 0 ) writes "-12.34"
+ * @param dest      Destination buffer
+ * @param value     The value scaled by 10 ^ decimals
+ * @param decimals  Digits after the point, 0 to 9
+ * @param width     Minimum field width, 0 for none
+ * @return          Pointer to the terminating null, for appending
+ */
+char *
+formatFixed ( char *dest, int32_t value, uint32_t decimals, uint32_t width )
+{
+    char field [ FORMAT_INT_SIZE + 2 ];
+    char *end = field + sizeof ( field );
+    uint32_t magnitude = ( value < 0 ) ? -( uint32_t ) value : ( uint32_t ) value;
+    char *start;
+
+    if ( decimals > 9 )
+    {
+        decimals = 9;
+    }
+
+    if ( decimals == 0 )
+    {
+        return formatInt ( dest, value, width );
+    }
+    start = writeDigits ( end, magnitude % g_powers_of_ten [ decimals ], decimals );
+    *--start = '.';
+    start = writeDigits ( start, magnitude / g_powers_of_ten [ decimals ], 1 );
+
+    if ( value < 0 )
+    {
+        *--start = '-';
+    }
+    return padField ( dest, start, end - start, width );
+}
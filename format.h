@@ -0,0 +1,69 @@
+/* @file    format.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Header file for the fixed-width number formatters
+ */
+
+#ifndef FORMAT_H_
+#define FORMAT_H_
+
+#include <stdint.h>
+
+//*****************************************************************************
+// Defined constants
+//*****************************************************************************
+
+// Longest formatted int32_t, sign and ten digits
+#define FORMAT_INT_SIZE         11
+
+// Copies a string literal, its length is known at compile time
+#define formatLiteral( dest, text )     formatCopy (( dest ), ( text ), sizeof ( text ) - 1 )
+
+//*****************************************************************************
+// Function declarations
+//*****************************************************************************
+
+/**
+ * Copies length characters and terminates the result. Used through
+ * formatLiteral for fixed message text
+ * @param dest      Destination buffer
+ * @param text      Characters to copy
+ * @param length    Number of characters
+ * @return          Pointer to the terminating null, for appending
+ */
+char *
+formatCopy ( char *dest, const char *text, uint32_t length );
+
+/**
+ * Copies a null terminated string
+ * @param dest  Destination buffer
+ * @param text  The string
+ * @return      Pointer to the terminating null, for appending
+ */
+char *
+formatString ( char *dest, const char *text );
+
+/**
+ * Writes a signed decimal, right aligned and space padded to width
+ * like "%*d"
+ * @param dest  Destination buffer
+ * @param value The value
+ * @param width Minimum field width, 0 for none
+ * @return      Pointer to the terminating null, for appending
+ */
+char *
+formatInt ( char *dest, int32_t value, uint32_t width );
+
+/**
+ * Writes a fixed point decimal, right aligned and space padded to width.
+ * formatFixed ( dest, -1234, 2, 0 ) writes "-12.34"
+ * @param dest      Destination buffer
+ * @param value     The value scaled by 10 ^ decimals
+ * @param decimals  Digits after the point, 0 to 9
+ * @param width     Minimum field width, 0 for none
+ * @return          Pointer to the terminating null, for appending
+ */
+char *
+formatFixed ( char *dest, int32_t value, uint32_t decimals, uint32_t width );
+
+#endif /* FORMAT_H_ */
@@ -10,12 +10,18 @@
 #include <stdbool.h>
 #include "driverlib/adc.h"
 #include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
 #include "driverlib/pin_map.h"
 #include "driverlib/sysctl.h"
 #include "inc/hw_memmap.h"
 #include "circBufT.h"
 #include "./OrbitOLED/OrbitOLEDInterface.h"
+#include "display.h"
+#include "format.h"
 #include "utils/ustdlib.h"
+#include "cycles.h"
+#include "events.h"
+#include "memory.h"
 
 //****************************************************************************
 // Defined constants
@@ -26,16 +32,66 @@
 #define MILLIVOLTS_PER_ADC_STEP 0.7324            // 3 V / 12 bits = 0.73 mV
 #define SEQUENCE_NO             3                 // The sequence number
 #define Y_POS                   3                 // The Y position on display
-#define GROUND_HEIGHT_BUFFER    500000            // Ground height delay buffer
+#define GROUND_SAMPLES          40                // Valid samples averaged for ground (0.5 s at 80 Hz)
+#define GROUND_OUTLIER_STEPS    40                // Max ADC step deviation from buffer mean for a valid sample
 #define MESSAGE_SIZE            24                // Size of message for display
 
 //****************************************************************************
 // Global variables
 //****************************************************************************
 
-static circBuf_t g_inBuffer;
+STATIC_CIRC_BUF ( g_inBuffer, BUF_SIZE );
 int32_t g_ground_height;
 
+static volatile uint32_t g_buf_fill = 0;          // Samples written until buffer is primed
+static volatile uint32_t g_ground_count = 0;      // Valid ground samples collected
+static volatile uint32_t g_ground_sum = 0;        // Sum of valid ground samples
+static volatile bool g_ground_set = false;        // Set once the ground reference is valid
+static volatile uint32_t g_sample_time = 0;       // Cycle count of the newest sample
+static uint32_t g_filter_len = BUF_SIZE;          // Samples averaged for the height
+
+/**
+ * Calculates the mean of the raw ADC buffer without moving its read index
+ * @return  The mean ADC value
+ */
+static uint32_t
+getBufferMean ( void )
+{
+    uint32_t sum = 0;
+    int i;
+
+    for ( i = 0; i < BUF_SIZE; i++ )
+    {
+        sum += g_inBuffer.data [ i ];
+    }
+    return ( sum + BUF_SIZE / 2 ) / BUF_SIZE;
+}
+
+/**
+ * Adds an ADC sample to the ground calibration if it is not an outlier,
+ * and sets the ground height once enough valid samples are collected
+ * @param sample    The raw ADC sample
+ */
+static void
+groundCalibrationSample ( uint32_t sample )
+{
+    uint32_t mean = getBufferMean ();
+    uint32_t deviation = ( sample > mean ) ? sample - mean : mean - sample;
+
+    if ( deviation > GROUND_OUTLIER_STEPS )
+    {
+        return;
+    }
+    g_ground_sum += sample;
+    ++g_ground_count;
+
+    if ( g_ground_count >= GROUND_SAMPLES )
+    {
+        g_ground_height = (( g_ground_sum + GROUND_SAMPLES / 2 ) / GROUND_SAMPLES ) * MILLIVOLTS_PER_ADC_STEP;
+        g_ground_set = true;
+    }
+}
+
 /**
  * ADC interrupt handler
  */
@@ -44,14 +100,27 @@ ADCIntHandler ( void )
 {
     uint32_t ulValue;
 
+    traceEvent ( EVT_ISR_ENTER, EVT_ISR_ADC, 0 );
+
     // Get the single sample from ADC0.  ADC_BASE is defined in inc/hw_memmap.h
     ADCSequenceDataGet ( ADC0_BASE, SEQUENCE_NO, &ulValue );
+    g_sample_time = getCycles ();
 
     // Place it in the circular buffer (advancing write index)
     writeCircBuf ( &g_inBuffer, ulValue );
 
+    // Collects ground samples once the buffer holds no unwritten entries
+    if ( g_buf_fill < BUF_SIZE )
+    {
+        ++g_buf_fill;
+    } else if ( !g_ground_set )
+    {
+        groundCalibrationSample ( ulValue );
+    }
+
     // Clean up, clearing the interrupt
     ADCIntClear ( ADC0_BASE, SEQUENCE_NO );
+    traceEvent ( EVT_ISR_EXIT, EVT_ISR_ADC, 0 );
 }
 
 /**
@@ -63,6 +132,10 @@ initADC ( void )
     // Resets ADC0 peripheral
     SysCtlPeripheralReset ( SYSCTL_PERIPH_ADC0 );
 
+    // The buffer must be cleared before the first conversion interrupt
+    initCircBuf ( &g_inBuffer );
+    registerMemory ( "height samples", CIRC_BUF_BYTES ( g_inBuffer ));
+
     // Enable PE4 & ADC
     GPIOPinTypeADC ( GPIO_PORTE_BASE, GPIO_PIN_4 );
 
@@ -96,13 +169,45 @@ uint16_t
 getADCvalue ( void )
 {
     int32_t sum = 0;
-    int i;
+    uint32_t index = g_inBuffer.windex;
+    uint32_t i;
 
-    for ( i = 0; i < BUF_SIZE; i++ )
+    // Averages the most recent g_filter_len samples
+    for ( i = 0; i < g_filter_len; i++ )
+    {
+        index = ( index == 0 ) ? BUF_SIZE - 1 : index - 1;
+        sum += g_inBuffer.data [ index ];
+    }
+    return (( 2 * sum + g_filter_len ) / 2 / g_filter_len );
+}
+
+/**
+ * Sets the number of recent samples averaged by the height filter
+ * @param length    The filter length, limited to 1 .. BUF_SIZE
+ */
+void
+setFilterLength ( uint32_t length )
+{
+    if ( length < 1 )
+    {
+        length = 1;
+    }
+
+    if ( length > BUF_SIZE )
     {
-        sum += readCircBuf ( &g_inBuffer );
+        length = BUF_SIZE;
     }
-    return (( 2 * sum + BUF_SIZE ) / 2 / BUF_SIZE );
+    g_filter_len = length;
+}
+
+/**
+ * Returns the number of recent samples averaged by the height filter
+ * @return  The filter length
+ */
+uint32_t
+getFilterLength ( void )
+{
+    return g_filter_len;
 }
 
 /**
@@ -116,19 +221,40 @@ getADCVolt ( void )
 }
 
 /**
- * Sets the ground height
+ * Starts the ground height calibration. Samples are collected by the ADC
+ * interrupt, so this returns immediately; poll isGroundSet for readiness
  */
 void
 ADCheightReference ( void )
 {
-    initCircBuf ( &g_inBuffer, BUF_SIZE );
-    int count = 0;
+    IntMasterDisable ();
+    g_ground_set = false;
+    g_ground_sum = 0;
+    g_ground_count = 0;
+    IntMasterEnable ();
+}
 
-    while ( count < GROUND_HEIGHT_BUFFER )
-    {
-        ++count;
-    }
-    g_ground_height = getADCVolt ();
+/**
+ * Sets the ground height from a stored reference, ending any calibration
+ * @param ground    The ground height in millivolts
+ */
+void
+setGround ( int32_t ground )
+{
+    IntMasterDisable ();
+    g_ground_height = ground;
+    g_ground_set = true;
+    IntMasterEnable ();
+}
+
+/**
+ * Returns whether the ground height calibration has completed
+ * @return  True once the ground height is valid
+ */
+bool
+isGroundSet ( void )
+{
+    return g_ground_set;
 }
 
 /**
@@ -149,8 +275,32 @@ void
 displayHeight ( void )
 {
     char message [ MESSAGE_SIZE ];
-    usprintf ( message, "Height: %d ",  getAltitudePercentage () );
-    OLEDStringDraw ( message, 0, Y_POS );
+    char *end = formatLiteral ( message, "Height: " );
+    end = formatInt ( end, getAltitudePercentage (), 0 );
+    formatLiteral ( end, " " );
+    displayString ( message, 0, Y_POS );
+}
+
+/**
+ * Returns the most recent raw ADC sample
+ * @return  The raw ADC value
+ */
+uint32_t
+getADCraw ( void )
+{
+    uint32_t index = g_inBuffer.windex;
+
+    return g_inBuffer.data [ ( index == 0 ) ? BUF_SIZE - 1 : index - 1 ];
+}
+
+/**
+ * Returns the time of the newest sample in the height filter
+ * @return  The cycle count when the sample was read
+ */
+uint32_t
+getADCtime ( void )
+{
+    return g_sample_time;
 }
 
 /**
@@ -7,6 +7,9 @@
 #ifndef HEIGHT_H_
 #define HEIGHT_H_
 
+#include <stdint.h>
+#include <stdbool.h>
+
 /**
  * Initializes the ADC for the height sensor
  */
@@ -21,11 +24,40 @@ int
 getADCVolt ( void );
 
 /**
- * Sets the ground height
+ * Starts the ground height calibration. Samples are collected by the ADC
+ * interrupt, so this returns immediately; poll isGroundSet for readiness
  */
 void
 ADCheightReference ( void );
 
+/**
+ * Sets the number of recent samples averaged by the height filter
+ * @param length    The filter length, limited to 1 .. BUF_SIZE
+ */
+void
+setFilterLength ( uint32_t length );
+
+/**
+ * Returns the number of recent samples averaged by the height filter
+ * @return  The filter length
+ */
+uint32_t
+getFilterLength ( void );
+
+/**
+ * Sets the ground height from a stored reference, ending any calibration
+ * @param ground    The ground height in millivolts
+ */
+void
+setGround ( int32_t ground );
+
+/**
+ * Returns whether the ground height calibration has completed
+ * @return  True once the ground height is valid
+ */
+bool
+isGroundSet ( void );
+
 /**
  * Calculates height as a percentage for displaying to Tiva LED
  * @return  The altitude as a percentage
@@ -39,6 +71,20 @@ getAltitudePercentage ( void );
 void
 displayHeight ( void );
 
+/**
+ * Returns the most recent raw ADC sample
+ * @return  The raw ADC value
+ */
+uint32_t
+getADCraw ( void );
+
+/**
+ * Returns the time of the newest sample in the height filter
+ * @return  The cycle count when the sample was read
+ */
+uint32_t
+getADCtime ( void );
+
 /**
  * Returns current height of ground
  * @return  The ground height
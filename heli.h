@@ -0,0 +1,102 @@
+/* @file    heli.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Controller context of one helicopter rig. Sensors, setpoints,
+ *          controllers, actuators and the flight state machine live in one
+ *          struct, ordered by how often they are touched, and every module
+ *          works on a pointer to it
+ */
+
+#ifndef HELI_H_
+#define HELI_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "metrics.h"
+
+//*****************************************************************************
+// Type definitions
+//*****************************************************************************
+
+// Gains for a single PID loop
+typedef struct {
+    float proportional;
+    float integral;
+    float differential;
+} gains_t;
+
+// Terms of the last output of a single PID loop, in duty cycle percent
+typedef struct {
+    float proportional;
+    float integral;
+    float differential;
+} pidTerms_t;
+
+// One PID loop
+typedef struct {
+    gains_t gains;
+    float last_error;               // Error of the previous update
+    float integral_error;           // Sum of errors while not saturated
+    pidTerms_t terms;               // Terms of the last output
+} pidState_t;
+
+// Readings taken at the start of each control update
+typedef struct {
+    int32_t altitude;               // Altitude, percent
+    int32_t yaw;                    // Yaw, degrees from the reference
+    uint32_t alt_time;              // Cycle count of the ADC sample behind altitude
+    uint32_t yaw_time;              // Cycle count of the yaw edge behind yaw
+} sensors_t;
+
+// Targets set by the buttons, commands and flight sequences
+typedef struct {
+    int32_t altitude;               // Altitude target, percent
+    int32_t yaw;                    // Yaw target, degrees from the reference
+} setpoints_t;
+
+// Controller outputs
+typedef struct {
+    int32_t main_duty;              // Main rotor output, whole percent
+    int32_t tail_duty;              // Tail rotor output, whole percent
+    uint32_t main_command;          // Main rotor output, Q16 duty
+    uint32_t tail_command;          // Tail rotor output, Q16 duty
+    uint32_t last_edge_time;        // Yaw edge already counted in the latency statistics
+    bool pwm_on;                    // Set while the PWM outputs are enabled
+} actuators_t;
+
+// Flight state machine
+typedef struct {
+    uint8_t state;                  // enum flightStates
+    bool flying_from_landed;        // Set once the mode switch starts low
+    bool start_up_sequence;         // Set until the yaw reference is found
+    bool calibrate;                 // Set while seeking the yaw reference
+    bool landing_sequence;          // Set while descending to land
+    uint32_t seek_updates;          // State updates spent seeking the reference
+} flightState_t;
+
+// Step responses of both loops
+typedef struct {
+    stepTracker_t alt_tracker;      // Altitude step response
+    stepTracker_t yaw_tracker;      // Yaw step response
+    stepMetrics_t alt_metrics;      // Last finished altitude step
+    stepMetrics_t yaw_metrics;      // Last finished yaw step
+    bool alt_report;                // Set until alt_metrics is sent
+    bool yaw_report;                // Set until yaw_metrics is sent
+    uint32_t sample_time;           // Cycle count of the altitude sample last followed
+    uint32_t cycles_per_us;         // System clock cycles per microsecond
+} controlMetrics_t;
+
+// Everything one rig's controller reads and writes. The control task walks
+// the first five members in order every tick, the button task reads the
+// flight state at a quarter of the rate and the metrics only follow steps
+typedef struct {
+    sensors_t sensors;
+    setpoints_t setpoints;
+    pidState_t main_pid;
+    pidState_t tail_pid;
+    actuators_t actuators;
+    flightState_t fsm;
+    controlMetrics_t metrics;
+} heli_t;
+
+#endif /* HELI_H_ */
@@ -0,0 +1,171 @@
+/* @file    latency.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Sensor to actuator latency statistics. Each ADC sample and yaw
+ *          edge is timestamped in its interrupt, the timestamp travels with
+ *          the reading through the controller and the PWM update records
+ *          the time since
+ */
+
+#include <stdint.h>
+#include "driverlib/sysctl.h"
+#include "height.h"
+#include "UART.h"
+#include "format.h"
+#include "latency.h"
+#include "memory.h"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define MESSAGE_SIZE            80      // Size of a dump line
+#define SAMPLE_PERIOD_US        12500   // ADC sample period, 1 / SAMPLE_RATE_HZ in main.c
+
+/**********************************************************
+ * Type definitions
+ **********************************************************/
+
+typedef struct {
+    uint32_t count;                     // Latencies recorded
+    uint32_t max;                       // Longest latency, microseconds
+    uint32_t histogram [ LATENCY_BINS ];        // Latencies by LATENCY_BIN_US bin
+} latencyStats_t;
+
+/**********************************************************
+ * Global variables
+ **********************************************************/
+
+static const char *const g_source_names [ NUM_LAT_SOURCES ] = { "alt", "yaw" };
+
+static latencyStats_t g_stats [ NUM_LAT_SOURCES ];
+static uint32_t g_cycles_per_us = 1;
+
+/**
+ * Reads the CPU clock for converting cycles to microseconds. Called after
+ * the clock is set
+ */
+void
+initLatency ( void )
+{
+    g_cycles_per_us = SysCtlClockGet () / 1000000;
+    registerMemory ( "latency", sizeof ( g_stats ));
+}
+
+/**
+ * Adds one sensor to actuator latency to the statistics of its source
+ * @param source    LAT_ALT or LAT_YAW
+ * @param cycles    CPU cycles from the sensor timestamp to the PWM update
+ */
+void
+recordLatency ( uint8_t source, uint32_t cycles )
+{
+    latencyStats_t *stats = &g_stats [ source ];
+    uint32_t us = cycles / g_cycles_per_us;
+    uint32_t bin = us / LATENCY_BIN_US;
+
+    if ( bin >= LATENCY_BINS )
+    {
+        bin = LATENCY_BINS - 1;
+    }
+
+    if ( us > stats->max )
+    {
+        stats->max = us;
+    }
+    ++stats->count;
+    ++stats->histogram [ bin ];
+}
+
+/**
+ * Returns a latency percentile of one source, to the histogram resolution
+ * @param source    LAT_ALT or LAT_YAW
+ * @param percent   The percentile, 1 to 100
+ * @return          Latency in microseconds, 0 if nothing recorded
+ */
+uint32_t
+getLatencyPercentile ( uint8_t source, uint32_t percent )
+{
+    const latencyStats_t *stats = &g_stats [ source ];
+    uint32_t rank = ( uint32_t ) (( uint64_t ) stats->count * percent / 100 );
+    uint32_t seen = 0;
+    uint32_t bin;
+
+    if ( stats->count == 0 )
+    {
+        return 0;
+    }
+
+    for ( bin = 0; bin < LATENCY_BINS - 1; bin++ )
+    {
+        seen += stats->histogram [ bin ];
+
+        if ( seen > rank || seen == stats->count )
+        {
+            break;
+        }
+    }
+
+    // Upper edge of the bin, never beyond the longest latency seen
+    return ( bin == LATENCY_BINS - 1 || ( bin + 1 ) * LATENCY_BIN_US > stats->max )
+            ? stats->max : ( bin + 1 ) * LATENCY_BIN_US;
+}
+
+/**
+ * Sends the count, 50th, 90th and 99th percentile and max latency of each
+ * source over UART
+ */
+void
+dumpLatency ( void )
+{
+    char message [ MESSAGE_SIZE ];
+    char *end;
+    uint8_t source;
+
+    for ( source = 0; source < NUM_LAT_SOURCES; source++ )
+    {
+        end = formatString ( message, g_source_names [ source ] );
+        end = formatLiteral ( end, " n " );
+        end = formatInt ( end, g_stats [ source ].count, 0 );
+        end = formatLiteral ( end, " p50 " );
+        end = formatInt ( end, getLatencyPercentile ( source, 50 ), 0 );
+        end = formatLiteral ( end, " p90 " );
+        end = formatInt ( end, getLatencyPercentile ( source, 90 ), 0 );
+        end = formatLiteral ( end, " p99 " );
+        end = formatInt ( end, getLatencyPercentile ( source, 99 ), 0 );
+        end = formatLiteral ( end, " max " );
+        end = formatInt ( end, g_stats [ source ].max, 0 );
+        end = formatLiteral ( end, " us" );
+
+        // The moving average adds its group delay on top of the newest sample
+        if ( source == LAT_ALT )
+        {
+            end = formatLiteral ( end, " filter +" );
+            end = formatInt ( end, ( getFilterLength () - 1 ) * SAMPLE_PERIOD_US / 2, 0 );
+            end = formatLiteral ( end, " us" );
+        }
+        formatLiteral ( end, "\r\n" );
+        sendUART ( message );
+    }
+}
+
+/**
+ * Clears the statistics of every source
+ */
+void
+clearLatency ( void )
+{
+    uint8_t source;
+    uint32_t bin;
+
+    for ( source = 0; source < NUM_LAT_SOURCES; source++ )
+    {
+        g_stats [ source ].count = 0;
+        g_stats [ source ].max = 0;
+
+        for ( bin = 0; bin < LATENCY_BINS; bin++ )
+        {
+            g_stats [ source ].histogram [ bin ] = 0;
+        }
+    }
+}
@@ -0,0 +1,63 @@
+/* @file    latency.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Header file for the sensor to actuator latency statistics
+ */
+
+#ifndef LATENCY_H_
+#define LATENCY_H_
+
+#include <stdint.h>
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define LATENCY_BIN_US          250     // Histogram bin width
+#define LATENCY_BINS            64      // Bins, the last also holds anything longer
+
+// Sensor inputs timed to the PWM update that uses them
+enum latencySources { LAT_ALT = 0, LAT_YAW, NUM_LAT_SOURCES };
+
+/**********************************************************
+ * Function declarations
+ **********************************************************/
+
+/**
+ * Reads the CPU clock for converting cycles to microseconds. Called after
+ * the clock is set
+ */
+void
+initLatency ( void );
+
+/**
+ * Adds one sensor to actuator latency to the statistics of its source
+ * @param source    LAT_ALT or LAT_YAW
+ * @param cycles    CPU cycles from the sensor timestamp to the PWM update
+ */
+void
+recordLatency ( uint8_t source, uint32_t cycles );
+
+/**
+ * Returns a latency percentile of one source, to the histogram resolution
+ * @param source    LAT_ALT or LAT_YAW
+ * @param percent   The percentile, 1 to 100
+ * @return          Latency in microseconds, 0 if nothing recorded
+ */
+uint32_t
+getLatencyPercentile ( uint8_t source, uint32_t percent );
+
+/**
+ * Sends the count, 50th, 90th and 99th percentile and max latency of each
+ * source over UART
+ */
+void
+dumpLatency ( void );
+
+/**
+ * Clears the statistics of every source
+ */
+void
+clearLatency ( void );
+
+#endif /* LATENCY_H_ */
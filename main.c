@@ -23,32 +23,46 @@
 #include "height.h"
 #include "yaw.h"
 #include "buttons.h"
+#include "flight.h"
 #include "PWM_main.h"
 #include "PWM_tail.h"
+#include "actuator.h"
 #include "PID.h"
+#include "control.h"
 #include "UART.h"
+#include "config.h"
+#include "cycles.h"
+#include "display.h"
+#include "command.h"
+#include "telemetry.h"
+#include "profile.h"
+#include "latency.h"
+#include "events.h"
+#include "recorder.h"
+#include "memory.h"
+#include "heli.h"
 
 //****************************************************************************
 // Defined constants
 //****************************************************************************
 
 #define SAMPLE_RATE_HZ          80      // Equation: 2NFm (2 * 10 * 4)
-#define COUNT                   150     // For the SysCtlDelay
 #define SEQUENCE_NO             3       // Process trigger sequence number
 #define TIVA_DISPLAY_STEP       25      // Value for Tiva display increments
 #define BUTTON_TIMER_STEP       4       // Value for button display increments
-#define UART_TIMER_STEP         75      // Value for UART timer increments
+#define DISPLAY_FLUSH_BUDGET    8       // OLED characters sent per loop pass
+#define EVENT_TRIGGER_LAG       2       // Control ticks behind SysTick that freeze the event trace
 
 //****************************************************************************
 // Global variables
 //****************************************************************************
 
-static uint32_t g_ulSampCnt = 0;               // Counter for the interrupts
+static volatile uint32_t g_ulSampCnt = 0;      // Counter for the interrupts
 uint32_t g_tiva_display = TIVA_DISPLAY_STEP;   // Timer for Tiva display
 uint32_t g_button_timer = BUTTON_TIMER_STEP;   // Timer for buttons
-uint32_t g_UART_timer = UART_TIMER_STEP;       // Timer for UART
+uint32_t g_UART_timer = 0;                     // Timer for UART
 uint32_t g_control_timer = 1;                  // Timer for control
-extern float g_yaw_angle;                      // External global for yaw angle
+static heli_t g_heli;                          // Controller context of the rig
 
 /**
  * The interrupt handler for the SysTick interrupt
@@ -56,11 +70,14 @@ extern float g_yaw_angle;                      // External global for yaw angle
 void
 SysTickIntHandler ( void )
 {
+    traceEvent ( EVT_ISR_ENTER, EVT_ISR_SYSTICK, 0 );
+
     // Trigger ADC conversion
     ADCProcessorTrigger ( ADC0_BASE, SEQUENCE_NO );
 
     // Counts the number of interrupts
     ++g_ulSampCnt;
+    traceEvent ( EVT_ISR_EXIT, EVT_ISR_SYSTICK, 0 );
 }
 
 /**
@@ -94,6 +111,23 @@ initDisplay ( void )
     OLEDInitialise ();  // Initializes the OLED
 }
 
+/**
+ * Renders the latest published yaw and rotor duty cycles to the shadow
+ * display. Runs as its own low rate task so no SPI traffic lands in the
+ * control path
+ * @param heli  The rig
+ */
+void
+updateDisplay ( const heli_t *heli )
+{
+    updateDisplayPWMmain ( heli->actuators.main_duty );
+    updateDisplayPWMtail ( heli->actuators.tail_duty );
+
+    profileBegin ( PROF_DISPLAY_YAW );
+    displayYaw ();
+    profileEnd ( PROF_DISPLAY_YAW );
+}
+
 /**
  * Resets the SysCtl peripherals for main and tail rotors
  */
@@ -124,9 +158,14 @@ int
 main ( void )
 {
     // Initializers
+    paintStack ();          // Marks the unused stack for the high-water mark
     peripheralReset ();     // Resets peripherals for main and tail rotors
     IntMasterDisable ();    // Disables all internal and external interrupts
     initClock ();           // Initializes the clock rate
+    initCycles ();          // Initializes the cycle counter for timestamps
+    initLatency ();         // Initializes the latency statistics
+    initProfile ();         // Initializes the task profiler
+    initEvents ();          // Initializes the event trace
     peripheralEnable ();    // Enables all ports
     initDisplay ();         // Initializes the LED display
     initButtons ();         // Initializes the buttons
@@ -134,38 +173,127 @@ main ( void )
     initYaw ();             // Initializes the yaw
     initPWMmain ();         // Initializes the main rotor PWM
     initPWMtail ();         // Initializes the tail rotor PWM
+    initActuator ();        // Initializes the rotor command shaping
     initUART ();            // Initializes the UART
+    initConfig ();          // Initializes the stored configuration
+    initControl ( &g_heli );        // Initializes the gains and controller outputs
+    initFlightState ( &g_heli );    // Initializes the flight state machine
+    initControlMetrics ( &g_heli ); // Initializes the step response metrics
+    registerMemory ( "controller", sizeof ( g_heli ));
+    initRecorder ();        // Initializes the flight data recorder
     IntMasterEnable ();     // Re-enables all internal and external interrupts
 
-    // Sets the initial ADC ground value
-    ADCheightReference ();
+    // A record saved at the last landing replaces ground and yaw calibration.
+    // It is consumed here so a power loss mid-flight forces re-calibration
+    if ( loadConfig ( &g_heli ) )
+    {
+        clearConfig ();
+    } else
+    {
+        // Starts collecting the initial ADC ground value
+        ADCheightReference ();
+    }
 
     while ( 1 )
     {
         if ( g_ulSampCnt > g_control_timer ) {
             g_control_timer += 1;
-            mainControl ();
-            tailControl ();
+            uint32_t lag = g_ulSampCnt - g_control_timer;
+            traceEvent ( EVT_TASK_START, EVT_TASK_CONTROL, 0 );
+
+            // The loop is paced by SysTick, so a lag means a pass overran a
+            // whole tick. In flight that is a fault, keeps the events around
+            // it; on the ground the dump commands hold the loop by design
+            if ( lag >= EVENT_TRIGGER_LAG && g_heli.actuators.pwm_on ) {
+                triggerEvents ();
+            }
+
+            // Drops the missed ticks rather than running control again on
+            // the same samples
+            g_control_timer += lag;
+
+            // Control is held off until the ground reference is valid
+            if ( isGroundSet () ) {
+                updateYawCorrection ();
+                sampleSensors ( &g_heli );
+
+                profileBegin ( PROF_MAIN_CONTROL );
+                mainControl ( &g_heli );
+                profileEnd ( PROF_MAIN_CONTROL );
+
+                profileBegin ( PROF_TAIL_CONTROL );
+                tailControl ( &g_heli );
+                profileEnd ( PROF_TAIL_CONTROL );
+
+                applyControl ( &g_heli );
+                updateControlMetrics ( &g_heli );
+            }
+
+            // Subscribed signals go out at the rate they were asked for
+            updateTelemetry ( &g_heli, g_control_timer, lag );
+
+            // Logs the tick, then does any flash work while the next tick is furthest away
+            recordFlight ( &g_heli, lag );
+            serviceRecorder ( &g_heli );
+            traceEvent ( EVT_TASK_STOP, EVT_TASK_CONTROL, 0 );
         }
 
         if ( g_ulSampCnt > g_button_timer ) {
             g_button_timer += BUTTON_TIMER_STEP;
-            checkButState ();
-            PWMtoggle ();
-            stateHandler ();
+            traceEvent ( EVT_TASK_START, EVT_TASK_BUTTONS, 0 );
+
+            if ( isGroundSet () ) {
+                flightInputs_t inputs;
+
+                profileBegin ( PROF_BUTTONS );
+                checkButState ( &g_heli, &inputs );
+                profileEnd ( PROF_BUTTONS );
+
+                PWMtoggle ( &g_heli );
+
+                profileBegin ( PROF_STATE );
+                stateHandler ( &g_heli, &inputs );
+                profileEnd ( PROF_STATE );
+            }
+            traceEvent ( EVT_TASK_STOP, EVT_TASK_BUTTONS, 0 );
         }
 
         if ( g_ulSampCnt > g_tiva_display ) {
             g_tiva_display += TIVA_DISPLAY_STEP;
-            displayYaw ();
+            traceEvent ( EVT_TASK_START, EVT_TASK_DISPLAY, 0 );
+            updateDisplay ( &g_heli );
+            updateMemory ();
+            traceEvent ( EVT_TASK_STOP, EVT_TASK_DISPLAY, 0 );
         }
 
         if ( g_ulSampCnt > g_UART_timer ) {
-            g_UART_timer += UART_TIMER_STEP;
-            UARTmessage ();
+            g_UART_timer += getTelemetryStep ();
+            traceEvent ( EVT_TASK_START, EVT_TASK_TELEMETRY, 0 );
+
+            // The text message is held off while binary frames are sent
+            if ( !isTelemetrySubscribed () ) {
+                profileBegin ( PROF_UART_MESSAGE );
+                UARTmessage ( &g_heli );
+                profileEnd ( PROF_UART_MESSAGE );
+            }
+            traceEvent ( EVT_TASK_STOP, EVT_TASK_TELEMETRY, 0 );
         }
 
-        // Sets the SysTick delay at approximately 50 Hz polling
-        SysCtlDelay ( SysCtlClockGet () / COUNT );
+        // Runs any command received over UART
+        traceEvent ( EVT_TASK_START, EVT_TASK_COMMAND, 0 );
+        processCommands ( &g_heli );
+        traceEvent ( EVT_TASK_STOP, EVT_TASK_COMMAND, 0 );
+
+        // Sends the metrics of any finished setpoint step
+        reportControlMetrics ( &g_heli );
+
+        // Sends only the changed OLED characters, a few per pass
+        traceEvent ( EVT_TASK_START, EVT_TASK_FLUSH, 0 );
+        flushDisplay ( DISPLAY_FLUSH_BUDGET );
+        traceEvent ( EVT_TASK_STOP, EVT_TASK_FLUSH, 0 );
+
+        // Waits for the next SysTick, so the control task runs once per tick
+        while ( g_ulSampCnt <= g_control_timer ) {
+        }
     }
 }
@@ -0,0 +1,149 @@
+/* @file    memory.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Stack painting and high-water mark and a report of every
+ *          registered buffer. Nothing is allocated at run time, so there
+ *          is no heap to report
+ */
+
+#include <stdint.h>
+#include "UART.h"
+#include "format.h"
+#include "memory.h"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define PAINT_MARGIN            16      // Words left unpainted below main's frame
+#define MESSAGE_SIZE            48      // Size of a report line
+
+/**********************************************************
+ * Type definitions
+ **********************************************************/
+
+typedef struct {
+    const char *name;
+    uint32_t bytes;
+} memoryBuffer_t;
+
+/**********************************************************
+ * Global variables
+ **********************************************************/
+
+// Defined by the TI linker from the -stack option
+extern uint32_t __stack;                // Lowest stack word, the stack grows down to it
+extern uint32_t __STACK_SIZE;           // The symbol's address is the stack size
+
+static memoryBuffer_t g_buffers [ MEMORY_MAX_BUFFERS ];
+static uint32_t g_buffer_count = 0;
+static uint32_t g_stack_peak = 0;       // Deepest stack use seen, bytes
+
+/**
+ * Fills the unused part of the stack with STACK_PAINT. Called first thing
+ * in main, before any interrupt is enabled
+ */
+void
+paintStack ( void )
+{
+    volatile uint32_t here;             // Its address is close to the stack pointer
+    uint32_t *word = &__stack;
+    uint32_t *top = ( uint32_t * ) &here - PAINT_MARGIN;
+
+    while ( word < top )
+    {
+        *word++ = STACK_PAINT;
+    }
+}
+
+/**
+ * Scans up from the bottom of the stack for the deepest overwritten word
+ * and keeps the high-water mark. Called from a low rate task, interrupts
+ * share the same stack so their nesting is included
+ */
+void
+updateMemory ( void )
+{
+    const uint32_t *word = &__stack;
+    uint32_t size = ( uint32_t ) ( uintptr_t ) &__STACK_SIZE;
+    uint32_t used;
+
+    while ( word < ( const uint32_t * ) (( uint8_t * ) &__stack + size ) && *word == STACK_PAINT )
+    {
+        ++word;
+    }
+    used = size - ( uint32_t ) (( const uint8_t * ) word - ( const uint8_t * ) &__stack );
+
+    if ( used > g_stack_peak )
+    {
+        g_stack_peak = used;
+    }
+}
+
+/**
+ * Returns the deepest stack use seen by updateMemory
+ * @return Bytes of stack used
+ */
+uint32_t
+getStackPeak ( void )
+{
+    return g_stack_peak;
+}
+
+/**
+ * Adds a buffer to the memory report
+ * @param name  Name in the report
+ * @param bytes Size of the buffer
+ */
+void
+registerMemory ( const char *name, uint32_t bytes )
+{
+    if ( g_buffer_count < MEMORY_MAX_BUFFERS )
+    {
+        g_buffers [ g_buffer_count ].name = name;
+        g_buffers [ g_buffer_count ].bytes = bytes;
+        ++g_buffer_count;
+    }
+}
+
+/**
+ * Sends the stack size and high-water mark, the total of the registered
+ * buffers and each buffer over UART
+ */
+void
+dumpMemory ( void )
+{
+    char message [ MESSAGE_SIZE ];
+    char *end;
+    uint32_t total = 0;
+    uint32_t i;
+
+    updateMemory ();
+
+    for ( i = 0; i < g_buffer_count; i++ )
+    {
+        total += g_buffers [ i ].bytes;
+    }
+
+    end = formatLiteral ( message, "stack " );
+    end = formatInt ( end, ( uint32_t ) ( uintptr_t ) &__STACK_SIZE, 0 );
+    end = formatLiteral ( end, " peak " );
+    end = formatInt ( end, g_stack_peak, 0 );
+    formatLiteral ( end, "\r\n" );
+    sendUART ( message );
+
+    end = formatLiteral ( message, "buffers " );
+    end = formatInt ( end, total, 0 );
+    formatLiteral ( end, "\r\n" );
+    sendUART ( message );
+
+    for ( i = 0; i < g_buffer_count; i++ )
+    {
+        end = formatLiteral ( message, "  " );
+        end = formatString ( end, g_buffers [ i ].name );
+        end = formatLiteral ( end, " " );
+        end = formatInt ( end, g_buffers [ i ].bytes, 0 );
+        formatLiteral ( end, "\r\n" );
+        sendUART ( message );
+    }
+}
@@ -0,0 +1,60 @@
+/* @file    memory.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Header file for the stack and buffer usage report
+ */
+
+#ifndef MEMORY_H_
+#define MEMORY_H_
+
+#include <stdint.h>
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define STACK_PAINT             0xDEADBEEF      // Fill of never used stack words
+#define MEMORY_MAX_BUFFERS      16              // Buffers the report can list
+
+/**********************************************************
+ * Function declarations
+ **********************************************************/
+
+/**
+ * Fills the unused part of the stack with STACK_PAINT. Called first thing
+ * in main, before any interrupt is enabled
+ */
+void
+paintStack ( void );
+
+/**
+ * Scans up from the bottom of the stack for the deepest overwritten word
+ * and keeps the high-water mark. Called from a low rate task, interrupts
+ * share the same stack so their nesting is included
+ */
+void
+updateMemory ( void );
+
+/**
+ * Returns the deepest stack use seen by updateMemory
+ * @return Bytes of stack used
+ */
+uint32_t
+getStackPeak ( void );
+
+/**
+ * Adds a buffer to the memory report
+ * @param name  Name in the report
+ * @param bytes Size of the buffer
+ */
+void
+registerMemory ( const char *name, uint32_t bytes );
+
+/**
+ * Sends the stack size and high-water mark, the total of the registered
+ * buffers and each buffer over UART
+ */
+void
+dumpMemory ( void );
+
+#endif /* MEMORY_H_ */
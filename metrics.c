@@ -0,0 +1,212 @@
+/* @file    metrics.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Step response metrics: rise time, overshoot, settling time,
+ *          steady-state error and integral absolute error. Plain C with no
+ *          hardware dependencies so bench and simulated runs share it
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "format.h"
+#include "metrics.h"
+
+/**
+ * Returns the magnitude of a value
+ * @param value The value
+ * @return      The magnitude
+ */
+static int32_t
+magnitude ( int32_t value )
+{
+    return ( value < 0 ) ? -value : value;
+}
+
+/**
+ * Converts microseconds to milliseconds
+ * @param us    The time in microseconds
+ * @return      The time in milliseconds
+ */
+static uint32_t
+usToMs ( uint64_t us )
+{
+    return ( uint32_t ) ( us / 1000 );
+}
+
+/**
+ * Starts following a new setpoint
+ * @param tracker   The tracker
+ * @param target    The new setpoint
+ * @param value     Current measured value
+ */
+static void
+startStep ( stepTracker_t *tracker, int32_t target, int32_t value )
+{
+    int32_t step = magnitude ( target - value );
+    int32_t band = step * METRICS_BAND_PERCENT / 100;
+
+    tracker->result.start = value;
+    tracker->result.target = target;
+    tracker->band = ( band > tracker->min_band ) ? band : tracker->min_band;
+    tracker->active = ( step != 0 );
+    tracker->time_us = 0;
+    tracker->t10 = 0;
+    tracker->t90 = 0;
+    tracker->peak = 0;
+    tracker->last_out = 0;
+    tracker->err_sum = 0;
+    tracker->err_count = 0;
+    tracker->iae_sum = 0;
+}
+
+/**
+ * Completes the step being followed
+ * @param tracker   The tracker
+ * @param settled   True if the value settled inside the band
+ * @param error     Latest setpoint minus value
+ * @param metrics   Destination for the metrics
+ */
+static void
+finishStep ( stepTracker_t *tracker, bool settled, int32_t error, stepMetrics_t *metrics )
+{
+    stepMetrics_t *result = &tracker->result;
+    int32_t step = magnitude ( result->target - result->start );
+
+    result->rise_ms = ( tracker->t10 && tracker->t90 ) ? usToMs ( tracker->t90 - tracker->t10 ) : 0;
+    result->overshoot = tracker->peak * 100 / step;
+    result->settle_ms = usToMs ( tracker->last_out );
+    result->ss_error = tracker->err_count ? tracker->err_sum / ( int32_t ) tracker->err_count : error;
+    result->iae = usToMs ( tracker->iae_sum );
+    result->settled = settled;
+    tracker->active = false;
+    *metrics = *result;
+}
+
+/**
+ * Initializes a step tracker
+ * @param tracker   The tracker
+ * @param min_band  Smallest settling band, value units
+ * @param target    Current setpoint, changes from here are followed
+ */
+void
+initStepTracker ( stepTracker_t *tracker, int32_t min_band, int32_t target )
+{
+    tracker->min_band = min_band;
+    tracker->active = false;
+    tracker->result.target = target;
+}
+
+/**
+ * Adds one sample of the loop. A setpoint change starts a new step
+ * @param tracker   The tracker
+ * @param target    Current setpoint
+ * @param value     Current measured value
+ * @param elapsed   Time since the previous sample, microseconds
+ * @param metrics   Destination for the metrics of a finished step
+ * @return          True if a step finished and metrics was written
+ */
+bool
+updateStepTracker ( stepTracker_t *tracker, int32_t target, int32_t value, uint32_t elapsed,
+                    stepMetrics_t *metrics )
+{
+    int32_t error = target - value;
+    bool finished = false;
+
+    if ( target != tracker->result.target )
+    {
+        // A step cut short by the next setpoint is still reported
+        if ( tracker->active )
+        {
+            finishStep ( tracker, false, error, metrics );
+            finished = true;
+        }
+        startStep ( tracker, target, value );
+        return finished;
+    }
+
+    if ( !tracker->active )
+    {
+        return false;
+    }
+
+    int32_t step = target - tracker->result.start;
+    int32_t progress = ( step > 0 ) ? value - tracker->result.start : tracker->result.start - value;
+    int32_t over = ( step > 0 ) ? -error : error;
+
+    tracker->time_us += elapsed;
+    tracker->iae_sum += ( uint64_t ) magnitude ( error ) * elapsed;
+
+    if ( !tracker->t10 && progress * 10 >= magnitude ( step ))
+    {
+        tracker->t10 = tracker->time_us;
+    }
+
+    if ( !tracker->t90 && progress * 10 >= magnitude ( step ) * 9 )
+    {
+        tracker->t90 = tracker->time_us;
+    }
+
+    if ( over > tracker->peak )
+    {
+        tracker->peak = over;
+    }
+
+    if ( magnitude ( error ) > tracker->band )
+    {
+        tracker->last_out = tracker->time_us;
+        tracker->err_sum = 0;
+        tracker->err_count = 0;
+    } else
+    {
+        tracker->err_sum += error;
+        ++tracker->err_count;
+    }
+
+    if ( tracker->t90 && usToMs ( tracker->time_us - tracker->last_out ) >= METRICS_HOLD_MS )
+    {
+        finishStep ( tracker, true, error, metrics );
+        return true;
+    }
+
+    if ( usToMs ( tracker->time_us ) >= METRICS_TIMEOUT_MS )
+    {
+        finishStep ( tracker, false, error, metrics );
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Formats a compact summary record of one step, e.g.
+ * "alt 10>20 rise 450 os 12 settle 1500 sse 0 iae 3400 ok"
+ * @param dest      Destination buffer, at least METRICS_RECORD_SIZE
+ * @param name      Loop name
+ * @param metrics   The step metrics
+ * @return          Pointer to the terminating null
+ */
+char *
+formatStepMetrics ( char *dest, const char *name, const stepMetrics_t *metrics )
+{
+    char *end = formatString ( dest, name );
+
+    end = formatLiteral ( end, " " );
+    end = formatInt ( end, metrics->start, 0 );
+    end = formatLiteral ( end, ">" );
+    end = formatInt ( end, metrics->target, 0 );
+    end = formatLiteral ( end, " rise " );
+    end = formatInt ( end, metrics->rise_ms, 0 );
+    end = formatLiteral ( end, " os " );
+    end = formatInt ( end, metrics->overshoot, 0 );
+    end = formatLiteral ( end, " settle " );
+    end = formatInt ( end, metrics->settle_ms, 0 );
+    end = formatLiteral ( end, " sse " );
+    end = formatInt ( end, metrics->ss_error, 0 );
+    end = formatLiteral ( end, " iae " );
+    end = formatInt ( end, metrics->iae, 0 );
+
+    if ( metrics->settled )
+    {
+        return formatLiteral ( end, " ok" );
+    }
+    return formatLiteral ( end, " cut" );
+}
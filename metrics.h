@@ -0,0 +1,93 @@
+/* @file    metrics.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Header file for the step response metrics
+ */
+
+#ifndef METRICS_H_
+#define METRICS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define METRICS_BAND_PERCENT    5       // Settling band, percent of the step
+#define METRICS_HOLD_MS         1000    // Time inside the band that counts as settled
+#define METRICS_TIMEOUT_MS      20000   // Longest step followed before giving up
+#define METRICS_RECORD_SIZE     96      // Longest formatted summary record
+
+/**********************************************************
+ * Type definitions
+ **********************************************************/
+
+// Summary of the response to one setpoint change
+typedef struct {
+    int32_t start;          // Value when the setpoint changed
+    int32_t target;         // New setpoint
+    uint32_t rise_ms;       // 10 % to 90 % of the step
+    uint32_t overshoot;     // Largest excursion past the setpoint, percent of the step
+    uint32_t settle_ms;     // Until the value last entered the settling band
+    int32_t ss_error;       // Mean setpoint minus value once settled
+    uint32_t iae;           // Integral of the absolute error, value units x ms
+    bool settled;           // False if the setpoint changed again or the step timed out
+} stepMetrics_t;
+
+// Tracks the response of one loop. Has no hardware dependencies so the
+// same code can run against a simulated plant. Times come from the caller
+// with each update, so a late or missed update does not skew them
+typedef struct {
+    stepMetrics_t result;   // Metrics of the step being followed
+    int32_t min_band;       // Settling band floor, value units
+    int32_t band;           // Settling band of the step being followed
+    bool active;            // Set while a step is being followed
+    uint32_t time_us;       // Time since the setpoint changed
+    uint32_t t10;           // Time the value passed 10 % of the step, 0 if not yet
+    uint32_t t90;           // Time the value passed 90 % of the step, 0 if not yet
+    int32_t peak;           // Largest excursion past the setpoint
+    uint32_t last_out;      // Last time outside the settling band
+    int32_t err_sum;        // Error sum since the value entered the band
+    uint32_t err_count;     // Updates since the value entered the band
+    uint64_t iae_sum;       // Sum of absolute errors, value units x us
+} stepTracker_t;
+
+/**********************************************************
+ * Function declarations
+ **********************************************************/
+
+/**
+ * Initializes a step tracker
+ * @param tracker   The tracker
+ * @param min_band  Smallest settling band, value units
+ * @param target    Current setpoint, changes from here are followed
+ */
+void
+initStepTracker ( stepTracker_t *tracker, int32_t min_band, int32_t target );
+
+/**
+ * Adds one sample of the loop. A setpoint change starts a new step
+ * @param tracker   The tracker
+ * @param target    Current setpoint
+ * @param value     Current measured value
+ * @param elapsed   Time since the previous sample, microseconds
+ * @param metrics   Destination for the metrics of a finished step
+ * @return          True if a step finished and metrics was written
+ */
+bool
+updateStepTracker ( stepTracker_t *tracker, int32_t target, int32_t value, uint32_t elapsed,
+                    stepMetrics_t *metrics );
+
+/**
+ * Formats a compact summary record of one step, e.g.
+ * "alt 10>20 rise 450 os 12 settle 1500 sse 0 iae 3400 ok"
+ * @param dest      Destination buffer, at least METRICS_RECORD_SIZE
+ * @param name      Loop name
+ * @param metrics   The step metrics
+ * @return          Pointer to the terminating null
+ */
+char *
+formatStepMetrics ( char *dest, const char *name, const stepMetrics_t *metrics );
+
+#endif /* METRICS_H_ */
@@ -0,0 +1,157 @@
+/* @file    profile.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Per task execution statistics from the DWT cycle counter
+ */
+
+#include <stdint.h>
+#include "UART.h"
+#include "format.h"
+#include "profile.h"
+#include "memory.h"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define MESSAGE_SIZE            64      // Size of a dump line
+
+/**********************************************************
+ * Type definitions
+ **********************************************************/
+
+typedef struct {
+    uint32_t count;                     // Executions recorded
+    uint32_t min;                       // Fewest cycles
+    uint32_t max;                       // Most cycles
+    uint64_t total;                     // Sum of cycles, for the mean
+    uint32_t histogram [ PROFILE_BUCKETS ];     // Executions by log2 of cycles
+} profileStats_t;
+
+/**********************************************************
+ * Global variables
+ **********************************************************/
+
+#ifdef PROFILE
+static const char *const g_scope_names [ NUM_PROF_SCOPES ] = {
+    "mainControl", "tailControl", "checkButState", "stateHandler", "displayYaw", "UARTmessage"
+};
+
+static profileStats_t g_stats [ NUM_PROF_SCOPES ];
+#endif
+
+/**
+ * Adds the scope statistics to the memory report. Does nothing unless
+ * built with PROFILE
+ */
+void
+initProfile ( void )
+{
+#ifdef PROFILE
+    registerMemory ( "profile", sizeof ( g_stats ));
+#endif
+}
+
+/**
+ * Adds one execution of a scope to its statistics
+ * @param scope     The scope
+ * @param cycles    CPU cycles the execution took
+ */
+void
+recordProfile ( uint8_t scope, uint32_t cycles )
+{
+#ifdef PROFILE
+    profileStats_t *stats = &g_stats [ scope ];
+    uint32_t bucket = 0;
+
+    // Bucket n holds 2^n to 2^(n + 1) - 1 cycles, the top bucket everything above
+    while ( bucket < PROFILE_BUCKETS - 1 && ( cycles >> ( bucket + 1 )))
+    {
+        ++bucket;
+    }
+
+    if ( stats->count == 0 || cycles < stats->min )
+    {
+        stats->min = cycles;
+    }
+
+    if ( cycles > stats->max )
+    {
+        stats->max = cycles;
+    }
+    ++stats->count;
+    stats->total += cycles;
+    ++stats->histogram [ bucket ];
+#endif
+}
+
+/**
+ * Sends the count, min, mean and max cycles of every scope over UART, each
+ * followed by its non-empty histogram buckets. Does nothing unless built
+ * with PROFILE
+ */
+void
+dumpProfile ( void )
+{
+#ifdef PROFILE
+    char message [ MESSAGE_SIZE ];
+    char *end;
+    uint8_t scope;
+    uint8_t bucket;
+
+    for ( scope = 0; scope < NUM_PROF_SCOPES; scope++ )
+    {
+        const profileStats_t *stats = &g_stats [ scope ];
+
+        end = formatString ( message, g_scope_names [ scope ] );
+        end = formatLiteral ( end, " n " );
+        end = formatInt ( end, stats->count, 0 );
+        end = formatLiteral ( end, " min " );
+        end = formatInt ( end, stats->min, 0 );
+        end = formatLiteral ( end, " mean " );
+        end = formatInt ( end, stats->count ? stats->total / stats->count : 0, 0 );
+        end = formatLiteral ( end, " max " );
+        end = formatInt ( end, stats->max, 0 );
+        formatLiteral ( end, "\r\n" );
+        sendUART ( message );
+
+        for ( bucket = 0; bucket < PROFILE_BUCKETS; bucket++ )
+        {
+            if ( stats->histogram [ bucket ] )
+            {
+                end = formatLiteral ( message, "  2^" );
+                end = formatInt ( end, bucket, 2 );
+                end = formatLiteral ( end, " " );
+                end = formatInt ( end, stats->histogram [ bucket ], 0 );
+                formatLiteral ( end, "\r\n" );
+                sendUART ( message );
+            }
+        }
+    }
+#endif
+}
+
+/**
+ * Clears the statistics of every scope
+ */
+void
+clearProfile ( void )
+{
+#ifdef PROFILE
+    uint8_t scope;
+    uint8_t bucket;
+
+    for ( scope = 0; scope < NUM_PROF_SCOPES; scope++ )
+    {
+        g_stats [ scope ].count = 0;
+        g_stats [ scope ].min = 0;
+        g_stats [ scope ].max = 0;
+        g_stats [ scope ].total = 0;
+
+        for ( bucket = 0; bucket < PROFILE_BUCKETS; bucket++ )
+        {
+            g_stats [ scope ].histogram [ bucket ] = 0;
+        }
+    }
+#endif
+}
@@ -0,0 +1,66 @@
+/* @file    profile.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Header file for the cycle counter task profiler
+ */
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+#include <stdint.h>
+#include "cycles.h"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define PROFILE_BUCKETS         24      // Log2 histogram buckets, 1 to 2^23 cycles
+
+// Profiled scopes
+enum profileScopes { PROF_MAIN_CONTROL = 0, PROF_TAIL_CONTROL, PROF_BUTTONS, PROF_STATE,
+                     PROF_DISPLAY_YAW, PROF_UART_MESSAGE, NUM_PROF_SCOPES };
+
+// Times the code between profileBegin and profileEnd of the same scope, in
+// the same block. Built in with PROFILE, otherwise both expand to nothing
+#ifdef PROFILE
+#define profileBegin( scope )   uint32_t scope##_start = getCycles ()
+#define profileEnd( scope )     recordProfile (( scope ), getCycles () - scope##_start )
+#else
+#define profileBegin( scope )
+#define profileEnd( scope )
+#endif
+
+/**********************************************************
+ * Function declarations
+ **********************************************************/
+
+/**
+ * Adds the scope statistics to the memory report. Does nothing unless
+ * built with PROFILE
+ */
+void
+initProfile ( void );
+
+/**
+ * Adds one execution of a scope to its statistics
+ * @param scope     The scope
+ * @param cycles    CPU cycles the execution took
+ */
+void
+recordProfile ( uint8_t scope, uint32_t cycles );
+
+/**
+ * Sends the count, min, mean and max cycles of every scope over UART, each
+ * followed by its non-empty histogram buckets. Does nothing unless built
+ * with PROFILE
+ */
+void
+dumpProfile ( void );
+
+/**
+ * Clears the statistics of every scope
+ */
+void
+clearProfile ( void );
+
+#endif /* PROFILE_H_ */
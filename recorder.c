@@ -0,0 +1,353 @@
+/* @file    recorder.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Full rate flight data recorder in a reserved flash region. The
+ *          region is written as a ring of pages so it wears evenly. Pages
+ *          are erased ahead on the ground with the rotors off: a page erase
+ *          stalls instruction fetch from flash for milliseconds, long
+ *          enough to lose yaw edges and a control update in flight. A
+ *          flight that outlasts them erases the oldest page as it goes, so
+ *          the end of the flight is always kept
+ */
+
+/**************************************************************
+ *    The linker command file must keep code out of            *
+ *    RECORDER_BASE .. RECORDER_BASE + RECORDER_SIZE           *
+ *                                                            *
+ *    Define RECORDER_RAM_FLASH to keep the region in RAM     *
+ *    with NOR flash program and erase rules (host builds,    *
+ *    see tools/recordertest.c)                               *
+ *************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "string.h"
+#include "driverlib/flash.h"
+#include "buttons.h"
+#include "height.h"
+#include "yaw.h"
+#include "PID.h"
+#include "PWM_main.h"
+#include "actuator.h"
+#include "UART.h"
+#include "recorder.h"
+#include "memory.h"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#ifndef RECORDER_BASE
+#define RECORDER_BASE           0x00020000      // Upper half of the 256 KB flash
+#endif
+#ifndef RECORDER_SIZE
+#define RECORDER_SIZE           0x00020000      // 4096 records, 51 s at 80 Hz
+#endif
+#define RECORDER_PAGE_SIZE      1024            // Flash erase block
+#define RECORDER_PAGES          ( RECORDER_SIZE / RECORDER_PAGE_SIZE )
+#define RECORDS_PER_PAGE        ( RECORDER_PAGE_SIZE / sizeof ( flightRecord_t ))
+#define RECORDER_RECORDS        ( RECORDER_PAGES * RECORDS_PER_PAGE )
+#define RECORDER_ERASE_AHEAD    (( RECORDER_PAGES - 1 ) / 2 )   // Pages erased for the next flight. A flight
+                                                        // this long needs no erase in flight
+#define RECORDER_QUEUE_SIZE     8               // Records waiting to be programmed, a power of two
+#define RECORDER_WRITES         4               // Records programmed per serviceRecorder call
+#define RECORDER_RATE_HZ        80              // Control ticks per second, SAMPLE_RATE_HZ in main.c
+#define CHECK_SEED              0xA5
+#define TERM_SCALE              100             // PID terms and duty recorded in 0.01 %
+#define DUTY_SCALE              10000           // Q16 duty to 0.01 %
+
+/**********************************************************
+ * Global variables
+ **********************************************************/
+
+#ifdef RECORDER_RAM_FLASH
+static uint32_t g_ram_flash [ RECORDER_SIZE / sizeof ( uint32_t ) ];
+#endif
+
+static flightRecord_t g_queue [ RECORDER_QUEUE_SIZE ];  // Records waiting for the flash
+static uint32_t g_queue_windex = 0;     // Written by recordFlight only
+static uint32_t g_queue_rindex = 0;     // Read by serviceRecorder only
+static uint32_t g_write_index = 0;      // Next record slot in the region
+static uint32_t g_next_seq = 0;         // Sequence number of the next record
+static uint32_t g_erase_page = 0;       // Next page to erase ahead of the writes
+static uint32_t g_erased_records = 0;   // Erased slots from g_write_index up to g_erase_page
+static uint32_t g_dropped = 0;          // Records lost to a full queue
+
+/**
+ * Returns a record slot in the region
+ * @param index Record slot, 0 to RECORDER_RECORDS - 1
+ * @return      The record, read straight from the memory mapped flash
+ */
+static const flightRecord_t *
+recordAt ( uint32_t index )
+{
+#ifdef RECORDER_RAM_FLASH
+    return ( const flightRecord_t * ) g_ram_flash + index;
+#else
+    return ( const flightRecord_t * ) RECORDER_BASE + index;
+#endif
+}
+
+/**
+ * Erases one page of the region
+ * @param page  Page in the region
+ */
+static void
+erasePage ( uint32_t page )
+{
+#ifdef RECORDER_RAM_FLASH
+    memset (( uint8_t * ) g_ram_flash + page * RECORDER_PAGE_SIZE, 0xFF, RECORDER_PAGE_SIZE );
+#else
+    FlashErase ( RECORDER_BASE + page * RECORDER_PAGE_SIZE );
+#endif
+}
+
+/**
+ * Programs one record into an erased slot
+ * @param index     Record slot
+ * @param record    The record
+ */
+static void
+programRecord ( uint32_t index, const flightRecord_t *record )
+{
+#ifdef RECORDER_RAM_FLASH
+    const uint32_t *source = ( const uint32_t * ) record;
+    uint32_t *dest = ( uint32_t * ) recordAt ( index );
+    uint32_t i;
+
+    // Programming can only clear bits
+    for ( i = 0; i < sizeof ( flightRecord_t ) / sizeof ( uint32_t ); i++ )
+    {
+        dest [ i ] &= source [ i ];
+    }
+#else
+    FlashProgram (( uint32_t * ) record, RECORDER_BASE + index * sizeof ( flightRecord_t ), sizeof ( flightRecord_t ));
+#endif
+}
+
+/**
+ * Calculates the check byte of a record
+ * @param record    The record
+ * @return          XOR of every byte but the check byte, and CHECK_SEED
+ */
+static uint8_t
+calculateCheck ( const flightRecord_t *record )
+{
+    const uint8_t *byte = ( const uint8_t * ) record;
+    uint8_t check = CHECK_SEED;
+    uint32_t i;
+
+    for ( i = 0; i < sizeof ( flightRecord_t ) - 1; i++ )
+    {
+        check ^= byte [ i ];
+    }
+    return check;
+}
+
+/**
+ * Returns true if a slot holds a complete record
+ * @param record    The slot
+ * @return          True if the record is valid
+ */
+static bool
+isRecordValid ( const flightRecord_t *record )
+{
+    return record->seq != RECORDER_EMPTY && record->check == calculateCheck ( record );
+}
+
+/**
+ * Scales a PID term to 0.01 % duty, saturated to 16 bits
+ * @param term  The term in duty percent
+ * @return      The scaled term
+ */
+static int16_t
+scaleTerm ( float term )
+{
+    float scaled = term * TERM_SCALE;
+
+    if ( scaled > INT16_MAX )
+    {
+        return INT16_MAX;
+    }
+
+    if ( scaled < INT16_MIN )
+    {
+        return INT16_MIN;
+    }
+    return ( int16_t ) scaled;
+}
+
+/**
+ * Finds the newest record in the flash region and prepares the page after
+ * it, so each power-up continues the ring instead of reusing the start
+ */
+void
+initRecorder ( void )
+{
+    uint32_t newest = RECORDER_RECORDS;
+    uint32_t page;
+    uint32_t i;
+
+    g_queue_windex = g_queue_rindex = 0;
+    g_next_seq = 0;
+    g_dropped = 0;
+
+    for ( i = 0; i < RECORDER_RECORDS; i++ )
+    {
+        const flightRecord_t *record = recordAt ( i );
+
+        if ( isRecordValid ( record ) && ( newest == RECORDER_RECORDS || record->seq >= g_next_seq ))
+        {
+            newest = i;
+            g_next_seq = record->seq + 1;
+        }
+    }
+
+    // Starts on a fresh page, a torn record may follow the newest one. The
+    // rest of the pages for the next flight are erased while still landed
+    page = ( newest == RECORDER_RECORDS ) ? 0 : ( newest / RECORDS_PER_PAGE + 1 ) % RECORDER_PAGES;
+    erasePage ( page );
+    g_write_index = page * RECORDS_PER_PAGE;
+    g_erase_page = ( page + 1 ) % RECORDER_PAGES;
+    g_erased_records = RECORDS_PER_PAGE;
+
+    registerMemory ( "recorder queue", sizeof ( g_queue ));
+}
+
+/**
+ * Captures the current control tick into the write queue while the
+ * helicopter is off the ground. Called from the control task, never
+ * touches the flash itself. The sequence number counts control ticks, so
+ * missed ticks and dropped records show as gaps in it
+ * @param heli      The rig
+ * @param missed    Control ticks missed since the last call
+ */
+void
+recordFlight ( const heli_t *heli, uint32_t missed )
+{
+    flightRecord_t *record;
+    uint32_t seq;
+
+    if ( heli->fsm.state == STATE_LANDED )
+    {
+        return;
+    }
+    seq = g_next_seq + missed;
+    g_next_seq = seq + 1;
+
+    if ( g_queue_windex - g_queue_rindex >= RECORDER_QUEUE_SIZE )
+    {
+        ++g_dropped;
+        return;
+    }
+    record = &g_queue [ g_queue_windex & ( RECORDER_QUEUE_SIZE - 1 ) ];
+
+    record->seq = seq;
+    record->adc = getADCraw ();
+    record->altitude = heli->sensors.altitude;
+    record->alt_target = heli->setpoints.altitude;
+    record->yaw = heli->sensors.yaw;
+    record->yaw_target = heli->setpoints.yaw;
+
+    record->main_terms [ 0 ] = scaleTerm ( heli->main_pid.terms.proportional );
+    record->main_terms [ 1 ] = scaleTerm ( heli->main_pid.terms.integral );
+    record->main_terms [ 2 ] = scaleTerm ( heli->main_pid.terms.differential );
+
+    record->tail_terms [ 0 ] = scaleTerm ( heli->tail_pid.terms.proportional );
+    record->tail_terms [ 1 ] = scaleTerm ( heli->tail_pid.terms.integral );
+    record->tail_terms [ 2 ] = scaleTerm ( heli->tail_pid.terms.differential );
+
+    record->main_duty = ( getActuatorOutput ( ACTUATOR_MAIN ) * DUTY_SCALE ) >> PWM_Q16_SHIFT;
+    record->tail_duty = ( getActuatorOutput ( ACTUATOR_TAIL ) * DUTY_SCALE ) >> PWM_Q16_SHIFT;
+    record->state = heli->fsm.state;
+    record->check = calculateCheck ( record );
+    ++g_queue_windex;
+}
+
+/**
+ * Programs queued records into the erased pages, a few per call. On the
+ * ground with the rotors off, erases one more page for the next flight
+ * instead, up to RECORDER_ERASE_AHEAD pages. A flight that fills the
+ * erased pages erases the oldest page in the call that finds them full,
+ * and the queue holds the records until it is done. The stall can miss a
+ * control tick, which shows as a gap in the sequence numbers. Called
+ * straight after the control task so a flash operation has the rest of
+ * the tick to complete in
+ * @param heli  The rig
+ */
+void
+serviceRecorder ( const heli_t *heli )
+{
+    uint32_t writes = RECORDER_WRITES;
+
+    while ( writes-- && g_queue_rindex != g_queue_windex )
+    {
+        // Out of erased pages in flight, the oldest page makes way. One
+        // erase is all the flash work this call does
+        if ( g_erased_records == 0 )
+        {
+            erasePage ( g_erase_page );
+            g_erase_page = ( g_erase_page + 1 ) % RECORDER_PAGES;
+            g_erased_records = RECORDS_PER_PAGE;
+            return;
+        }
+        programRecord ( g_write_index, &g_queue [ g_queue_rindex & ( RECORDER_QUEUE_SIZE - 1 ) ] );
+        ++g_queue_rindex;
+        g_write_index = ( g_write_index + 1 ) % RECORDER_RECORDS;
+        --g_erased_records;
+    }
+
+    if ( heli->fsm.state == STATE_LANDED && !heli->actuators.pwm_on && g_queue_rindex == g_queue_windex
+            && g_erased_records < RECORDER_ERASE_AHEAD * RECORDS_PER_PAGE )
+    {
+        erasePage ( g_erase_page );
+        g_erase_page = ( g_erase_page + 1 ) % RECORDER_PAGES;
+        g_erased_records += RECORDS_PER_PAGE;
+    }
+}
+
+/**
+ * Sends the header and every valid record over UART, oldest first
+ * @param heli  The rig
+ * @return      False if the helicopter is not landed
+ */
+bool
+dumpRecorder ( const heli_t *heli )
+{
+    recorderHeader_t header;
+    uint32_t first;
+    uint32_t i;
+
+    if ( heli->fsm.state != STATE_LANDED )
+    {
+        return false;
+    }
+
+    // The ring is oldest just after the page being written
+    first = ( g_write_index / RECORDS_PER_PAGE + 1 ) % RECORDER_PAGES * RECORDS_PER_PAGE;
+
+    header.magic = RECORDER_MAGIC;
+    header.rate_hz = RECORDER_RATE_HZ;
+    header.count = 0;
+    header.dropped = g_dropped;
+
+    for ( i = 0; i < RECORDER_RECORDS; i++ )
+    {
+        if ( isRecordValid ( recordAt (( first + i ) % RECORDER_RECORDS )))
+        {
+            ++header.count;
+        }
+    }
+    sendUARTbytes (( uint8_t * ) &header, sizeof ( header ));
+
+    for ( i = 0; i < RECORDER_RECORDS; i++ )
+    {
+        const flightRecord_t *record = recordAt (( first + i ) % RECORDER_RECORDS );
+
+        if ( isRecordValid ( record ))
+        {
+            sendUARTbytes (( const uint8_t * ) record, sizeof ( flightRecord_t ));
+        }
+    }
+    return true;
+}
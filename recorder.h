@@ -0,0 +1,93 @@
+/* @file    recorder.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Header file for the flash flight data recorder
+ */
+
+#ifndef RECORDER_H_
+#define RECORDER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "heli.h"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define RECORDER_MAGIC          0x43524446      // "FDRC"
+#define RECORDER_EMPTY          0xFFFFFFFF      // Sequence number of erased flash
+
+/**********************************************************
+ * Type definitions
+ **********************************************************/
+
+// One control tick, 32 bytes so a record never spans a flash page
+typedef struct {
+    uint32_t seq;               // Control ticks off the ground since the flash was first used
+    uint16_t adc;               // Raw height sample
+    int16_t altitude;           // Altitude percent
+    int16_t alt_target;         // Altitude setpoint percent
+    int16_t yaw;                // Yaw degrees
+    int16_t yaw_target;         // Yaw setpoint degrees
+    int16_t main_terms [ 3 ];   // Main P, I, D in 0.01 % duty
+    int16_t tail_terms [ 3 ];   // Tail P, I, D in 0.01 % duty
+    uint16_t main_duty;         // Main output in 0.01 % duty
+    uint16_t tail_duty;         // Tail output in 0.01 % duty
+    uint8_t state;              // Flight state, enum flightStates
+    uint8_t check;              // XOR of the other bytes and 0xA5, catches torn writes
+} flightRecord_t;
+
+// Download header, sent little-endian ahead of the records
+typedef struct {
+    uint32_t magic;             // RECORDER_MAGIC
+    uint32_t rate_hz;           // Records per second while recording
+    uint32_t count;             // Number of flightRecord_t records that follow
+    uint32_t dropped;           // Records lost to a full queue since power-up
+} recorderHeader_t;
+
+/**********************************************************
+ * Function declarations
+ **********************************************************/
+
+/**
+ * Finds the newest record in the flash region and prepares the page after
+ * it, so each power-up continues the ring instead of reusing the start
+ */
+void
+initRecorder ( void );
+
+/**
+ * Captures the current control tick into the write queue while the
+ * helicopter is off the ground. Called from the control task, never
+ * touches the flash itself. The sequence number counts control ticks, so
+ * missed ticks and dropped records show as gaps in it
+ * @param heli      The rig
+ * @param missed    Control ticks missed since the last call
+ */
+void
+recordFlight ( const heli_t *heli, uint32_t missed );
+
+/**
+ * Programs queued records into the erased pages, a few per call. On the
+ * ground with the rotors off, erases one more page for the next flight
+ * instead, up to RECORDER_ERASE_AHEAD pages. A flight that fills the
+ * erased pages erases the oldest page in the call that finds them full,
+ * and the queue holds the records until it is done. The stall can miss a
+ * control tick, which shows as a gap in the sequence numbers. Called
+ * straight after the control task so a flash operation has the rest of
+ * the tick to complete in
+ * @param heli  The rig
+ */
+void
+serviceRecorder ( const heli_t *heli );
+
+/**
+ * Sends the header and every valid record over UART, oldest first
+ * @param heli  The rig
+ * @return      False if the helicopter is not landed
+ */
+bool
+dumpRecorder ( const heli_t *heli );
+
+#endif /* RECORDER_H_ */
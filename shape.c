@@ -0,0 +1,88 @@
+/* @file    shape.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Shapes the control outputs before they reach the rotor PWMs.
+ *          Has no hardware access or module state, so the simulator runs
+ *          the same shaping as the rig
+ */
+
+/**************************************************************
+ *    Each command is linearized through the thrust table,     *
+ *    offset past the motor dead band, then rate limited       *
+ *************************************************************/
+
+#include <stdint.h>
+#include "PWM_main.h"
+#include "shape.h"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define MAIN_RATE_LIMIT         ( PWM_Q16_ONE / 100 )   // 1 % per update, full range in 1.25 s
+#define TAIL_RATE_LIMIT         ( PWM_Q16_ONE / 50 )    // 2 % per update
+#define LINEAR_TABLE            { 0, 8192, 16384, 24576, 32768, 40960, 49152, 57344, 65536 }
+
+/**********************************************************
+ * Global variables
+ **********************************************************/
+
+static const actuatorShape_t g_default_shape [ NUM_ACTUATORS ] = {
+    { MAIN_RATE_LIMIT, 0, LINEAR_TABLE },
+    { TAIL_RATE_LIMIT, 0, LINEAR_TABLE }
+};
+
+/**
+ * Returns the default shaping of one actuator channel
+ * @param channel   ACTUATOR_MAIN or ACTUATOR_TAIL
+ * @return          The default shaping
+ */
+const actuatorShape_t *
+getDefaultShape ( uint8_t channel )
+{
+    return &g_default_shape [ channel < NUM_ACTUATORS ? channel : ACTUATOR_MAIN ];
+}
+
+/**
+ * Shapes a command for one channel: linearized through the thrust table,
+ * offset past the motor dead band, then rate limited from the last output
+ * @param shape     The channel shaping
+ * @param last      Duty cycle of the previous update, Q16
+ * @param command   Requested thrust, Q16
+ * @return          Duty cycle to apply, Q16
+ */
+uint32_t
+shapeCommand ( const actuatorShape_t *shape, uint32_t last, uint32_t command )
+{
+    uint32_t duty = 0;
+
+    if ( command > PWM_Q16_ONE )
+    {
+        command = PWM_Q16_ONE;
+    }
+
+    if ( command > 0 )
+    {
+        // Interpolates the thrust table
+        uint32_t position = command * ( ACTUATOR_TABLE_POINTS - 1 );
+        uint32_t index = position >> PWM_Q16_SHIFT;
+        uint32_t fraction = position & ( PWM_Q16_ONE - 1 );
+        int32_t low = shape->thrust_table [ index ];
+        int32_t high = ( index < ACTUATOR_TABLE_POINTS - 1 ) ? ( int32_t ) shape->thrust_table [ index + 1 ] : low;
+
+        duty = low + ( int32_t ) ((( int64_t ) ( high - low ) * fraction ) >> PWM_Q16_SHIFT );
+
+        // Offsets into the range where the motor produces thrust
+        duty = shape->dead_band + ( uint32_t ) ((( uint64_t ) duty * ( PWM_Q16_ONE - shape->dead_band )) >> PWM_Q16_SHIFT );
+    }
+
+    // Limits the change from the last output
+    if ( duty > last + shape->rate_limit )
+    {
+        duty = last + shape->rate_limit;
+    } else if ( duty + shape->rate_limit < last )
+    {
+        duty = last - shape->rate_limit;
+    }
+    return duty;
+}
@@ -0,0 +1,55 @@
+/* @file    shape.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Header file for the rotor command shaping
+ */
+
+#ifndef SHAPE_H_
+#define SHAPE_H_
+
+#include <stdint.h>
+
+//*****************************************************************************
+// Defined constants
+//*****************************************************************************
+
+#define ACTUATOR_TABLE_POINTS   9       // Thrust linearization points, 0 .. 100 %
+
+// Actuator channels
+enum actuatorNames { ACTUATOR_MAIN = 0, ACTUATOR_TAIL, NUM_ACTUATORS };
+
+//*****************************************************************************
+// Type definitions
+//*****************************************************************************
+
+// Shaping applied to one channel between the controller and the PWM, all Q16
+typedef struct {
+    uint32_t rate_limit;        // Largest duty change per update
+    uint32_t dead_band;         // Duty at which the motor starts producing thrust
+    uint32_t thrust_table [ ACTUATOR_TABLE_POINTS ];   // Duty for evenly spaced thrust
+} actuatorShape_t;
+
+//*****************************************************************************
+// Function declarations
+//*****************************************************************************
+
+/**
+ * Returns the default shaping of one actuator channel
+ * @param channel   ACTUATOR_MAIN or ACTUATOR_TAIL
+ * @return          The default shaping
+ */
+const actuatorShape_t *
+getDefaultShape ( uint8_t channel );
+
+/**
+ * Shapes a command for one channel: linearized through the thrust table,
+ * offset past the motor dead band, then rate limited from the last output
+ * @param shape     The channel shaping
+ * @param last      Duty cycle of the previous update, Q16
+ * @param command   Requested thrust, Q16
+ * @return          Duty cycle to apply, Q16
+ */
+uint32_t
+shapeCommand ( const actuatorShape_t *shape, uint32_t last, uint32_t command );
+
+#endif /* SHAPE_H_ */
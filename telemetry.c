@@ -0,0 +1,328 @@
+/* @file    telemetry.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Subscription based binary telemetry. Each signal is sampled at its
+ *          own decimation of the control rate and only the signals due on a
+ *          tick are packed into that tick's frame
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "utils/ustdlib.h"
+#include "buttons.h"
+#include "height.h"
+#include "yaw.h"
+#include "PID.h"
+#include "PWM_main.h"
+#include "actuator.h"
+#include "UART.h"
+#include "telemetry.h"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define TELEMETRY_TICK_HZ       80      // Control rate (SAMPLE_RATE_HZ in main.c)
+#define TELEMETRY_FRAME_SIZE    64      // Largest frame, every signal present
+#define TERM_SCALE              100     // PID terms and duty sent in 0.01 %
+#define DUTY_SCALE              10000   // Q16 duty to 0.01 %
+
+/**********************************************************
+ * Type definitions
+ **********************************************************/
+
+typedef struct {
+    const char *name;           // Name used by the sub command
+    uint8_t size;               // Payload bytes
+} telemetrySignal_t;
+
+/**********************************************************
+ * Global variables
+ **********************************************************/
+
+static const telemetrySignal_t g_signals [ NUM_TLM_SIGNALS ] = {
+    { "adc", 2 },
+    { "alt", 2 },
+    { "yaw", 4 },
+    { "mainpid", 6 },
+    { "tailpid", 6 },
+    { "duty", 4 },
+    { "sched", 4 },
+    { "fsm", 1 },
+};
+
+static uint32_t g_decimation [ NUM_TLM_SIGNALS ];   // Ticks between samples, 0 if off
+static uint32_t g_late_ticks = 0;                   // Control ticks run behind SysTick
+
+/**
+ * Stores a 16 bit value, little endian
+ * @param dest  Destination buffer
+ * @param value The value
+ * @return      Pointer to the byte after the value
+ */
+static uint8_t *
+putU16 ( uint8_t *dest, uint16_t value )
+{
+    dest [ 0 ] = value & 0xFF;
+    dest [ 1 ] = value >> 8;
+    return dest + 2;
+}
+
+/**
+ * Stores a 32 bit value, little endian
+ * @param dest  Destination buffer
+ * @param value The value
+ * @return      Pointer to the byte after the value
+ */
+static uint8_t *
+putU32 ( uint8_t *dest, uint32_t value )
+{
+    dest = putU16 ( dest, value & 0xFFFF );
+    return putU16 ( dest, value >> 16 );
+}
+
+/**
+ * Stores a PID term in 0.01 % duty, saturated to 16 bits
+ * @param dest  Destination buffer
+ * @param term  The term in duty percent
+ * @return      Pointer to the byte after the value
+ */
+static uint8_t *
+putTerm ( uint8_t *dest, float term )
+{
+    float scaled = term * TERM_SCALE;
+
+    if ( scaled > INT16_MAX )
+    {
+        scaled = INT16_MAX;
+    } else if ( scaled < INT16_MIN )
+    {
+        scaled = INT16_MIN;
+    }
+    return putU16 ( dest, ( int16_t ) scaled );
+}
+
+/**
+ * Stores the three terms of one PID loop
+ * @param dest  Destination buffer
+ * @param terms The terms
+ * @return      Pointer to the byte after the terms
+ */
+static uint8_t *
+putTerms ( uint8_t *dest, const pidTerms_t *terms )
+{
+    dest = putTerm ( dest, terms->proportional );
+    dest = putTerm ( dest, terms->integral );
+    return putTerm ( dest, terms->differential );
+}
+
+/**
+ * Packs the payload of one signal
+ * @param heli      The rig
+ * @param dest      Destination buffer
+ * @param signal    The signal
+ * @param lag       Ticks the control task is running behind SysTick
+ * @return          Pointer to the byte after the payload
+ */
+static uint8_t *
+packSignal ( const heli_t *heli, uint8_t *dest, uint8_t signal, uint32_t lag )
+{
+    switch ( signal )
+    {
+    case TLM_ADC:
+        return putU16 ( dest, getADCraw ());
+    case TLM_ALT:
+        return putU16 ( dest, getAltitudePercentage ());
+    case TLM_YAW:
+        return putU32 ( dest, getYawTicks ());
+    case TLM_MAIN_PID:
+        return putTerms ( dest, &heli->main_pid.terms );
+    case TLM_TAIL_PID:
+        return putTerms ( dest, &heli->tail_pid.terms );
+    case TLM_DUTY:
+        dest = putU16 ( dest, ( getActuatorOutput ( ACTUATOR_MAIN ) * DUTY_SCALE ) >> PWM_Q16_SHIFT );
+        return putU16 ( dest, ( getActuatorOutput ( ACTUATOR_TAIL ) * DUTY_SCALE ) >> PWM_Q16_SHIFT );
+    case TLM_SCHED:
+        dest = putU16 ( dest, ( lag > UINT16_MAX ) ? UINT16_MAX : lag );
+        return putU16 ( dest, g_late_ticks );
+    case TLM_FSM:
+        *dest = heli->fsm.state;
+        return dest + 1;
+    }
+    return dest;
+}
+
+/**
+ * Returns the worst case link use of a set of decimations
+ * @param decimation    Ticks between samples of each signal, 0 if off
+ * @return              The telemetry load in bytes per second
+ */
+static uint32_t
+estimateLoad ( const uint32_t decimation [ NUM_TLM_SIGNALS ] )
+{
+    uint32_t frames = 0;
+    uint32_t bytes = 0;
+    uint8_t signal;
+
+    for ( signal = 0; signal < NUM_TLM_SIGNALS; signal++ )
+    {
+        if ( decimation [ signal ] )
+        {
+            uint32_t samples = ( TELEMETRY_TICK_HZ + decimation [ signal ] - 1 ) / decimation [ signal ];
+
+            frames += samples;
+            bytes += samples * g_signals [ signal ].size;
+        }
+    }
+
+    // Signals due on the same tick share a frame
+    if ( frames > TELEMETRY_TICK_HZ )
+    {
+        frames = TELEMETRY_TICK_HZ;
+    }
+    return bytes + frames * ( TELEMETRY_HEADER_SIZE + TELEMETRY_CHECK_SIZE );
+}
+
+/**
+ * Looks up a telemetry signal by its command name
+ * @param name  The signal name, e.g. "yaw"
+ * @return      The signal, NUM_TLM_SIGNALS if unknown
+ */
+uint8_t
+findTelemetrySignal ( const char *name )
+{
+    uint8_t signal;
+
+    for ( signal = 0; signal < NUM_TLM_SIGNALS; signal++ )
+    {
+        if ( ustrcmp ( name, g_signals [ signal ].name ) == 0 )
+        {
+            break;
+        }
+    }
+    return signal;
+}
+
+/**
+ * Subscribes a signal at its own rate. The subscription is refused if all
+ * subscribed signals together would exceed the telemetry share of the link
+ * @param signal        The signal
+ * @param decimation    Control ticks between samples, 0 to unsubscribe
+ * @return              True if the subscription was changed
+ */
+bool
+setTelemetryRate ( uint8_t signal, uint32_t decimation )
+{
+    uint32_t trial [ NUM_TLM_SIGNALS ];
+    uint8_t i;
+
+    if ( signal >= NUM_TLM_SIGNALS )
+    {
+        return false;
+    }
+
+    for ( i = 0; i < NUM_TLM_SIGNALS; i++ )
+    {
+        trial [ i ] = g_decimation [ i ];
+    }
+    trial [ signal ] = decimation;
+
+    if ( estimateLoad ( trial ) > getTelemetryBudget ())
+    {
+        return false;
+    }
+
+    g_decimation [ signal ] = decimation;
+    return true;
+}
+
+/**
+ * Returns the decimation of a signal
+ * @param signal    The signal
+ * @return          Control ticks between samples, 0 if unsubscribed
+ */
+uint32_t
+getTelemetryRate ( uint8_t signal )
+{
+    return ( signal < NUM_TLM_SIGNALS ) ? g_decimation [ signal ] : 0;
+}
+
+/**
+ * Returns true if any signal is subscribed. The text telemetry message is
+ * held off while binary frames are being sent
+ * @return True if any signal is subscribed
+ */
+bool
+isTelemetrySubscribed ( void )
+{
+    uint8_t signal;
+
+    for ( signal = 0; signal < NUM_TLM_SIGNALS; signal++ )
+    {
+        if ( g_decimation [ signal ] )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Returns the worst case link use of the current subscriptions
+ * @return The telemetry load in bytes per second
+ */
+uint32_t
+getTelemetryLoad ( void )
+{
+    return estimateLoad ( g_decimation );
+}
+
+/**
+ * Packs the signals due on this control tick into one frame and sends it.
+ * Sends nothing if no signal is due
+ * @param heli  The rig
+ * @param tick  The control tick
+ * @param lag   Ticks the control task is running behind SysTick
+ */
+void
+updateTelemetry ( const heli_t *heli, uint32_t tick, uint32_t lag )
+{
+    uint8_t frame [ TELEMETRY_FRAME_SIZE ];
+    uint8_t *end = frame + TELEMETRY_HEADER_SIZE;
+    uint16_t mask = 0;
+    uint8_t check = 0;
+    uint8_t signal;
+    uint8_t *byte;
+
+    if ( lag )
+    {
+        ++g_late_ticks;
+    }
+
+    for ( signal = 0; signal < NUM_TLM_SIGNALS; signal++ )
+    {
+        if ( g_decimation [ signal ] && tick % g_decimation [ signal ] == 0 )
+        {
+            mask |= 1 << signal;
+            end = packSignal ( heli, end, signal, lag );
+        }
+    }
+
+    if ( !mask )
+    {
+        return;
+    }
+
+    frame [ 0 ] = TELEMETRY_SYNC_0;
+    frame [ 1 ] = TELEMETRY_SYNC_1;
+    putU16 ( frame + 2, tick & 0xFFFF );
+    putU16 ( frame + 4, mask );
+
+    for ( byte = frame + 2; byte < end; byte++ )
+    {
+        check ^= *byte;
+    }
+    *end++ = check;
+
+    sendUARTbytes ( frame, end - frame );
+}
@@ -0,0 +1,101 @@
+/* @file    telemetry.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Header file for the subscription based binary telemetry
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "heli.h"
+
+//*****************************************************************************
+// Defined constants
+//*****************************************************************************
+
+#define TELEMETRY_SYNC_0        0xA5    // First frame sync byte
+#define TELEMETRY_SYNC_1        0x5A    // Second frame sync byte
+#define TELEMETRY_HEADER_SIZE   6       // Sync, tick and signal mask
+#define TELEMETRY_CHECK_SIZE    1       // Trailing XOR checksum
+
+// Telemetry signals, also the bit of each signal in the frame mask
+enum telemetrySignals { TLM_ADC = 0, TLM_ALT, TLM_YAW, TLM_MAIN_PID, TLM_TAIL_PID,
+                        TLM_DUTY, TLM_SCHED, TLM_FSM, NUM_TLM_SIGNALS };
+
+/**************************************************************
+ *    Frame, all values little endian:                        *
+ *      0xA5 0x5A               sync                          *
+ *      uint16_t tick           control tick, wraps           *
+ *      uint16_t mask           signals present, bit per enum *
+ *      payload                 each present signal in order  *
+ *      uint8_t check           XOR of the tick to payload    *
+ *                                                            *
+ *    Payloads:                                               *
+ *      adc     uint16_t        latest raw sample             *
+ *      alt     int16_t         altitude percent              *
+ *      yaw     int32_t         quadrature count              *
+ *      mainpid int16_t x 3     P, I, D in 0.01 % duty        *
+ *      tailpid int16_t x 3     P, I, D in 0.01 % duty        *
+ *      duty    uint16_t x 2    main, tail in 0.01 % duty     *
+ *      sched   uint16_t x 2    control lag, late ticks       *
+ *      fsm     uint8_t         landed, Flying, landing, Cal  *
+ *************************************************************/
+
+//*****************************************************************************
+// Function declarations
+//*****************************************************************************
+
+/**
+ * Looks up a telemetry signal by its command name
+ * @param name  The signal name, e.g. "yaw"
+ * @return      The signal, NUM_TLM_SIGNALS if unknown
+ */
+uint8_t
+findTelemetrySignal ( const char *name );
+
+/**
+ * Subscribes a signal at its own rate. The subscription is refused if all
+ * subscribed signals together would exceed the telemetry share of the link
+ * @param signal        The signal
+ * @param decimation    Control ticks between samples, 0 to unsubscribe
+ * @return              True if the subscription was changed
+ */
+bool
+setTelemetryRate ( uint8_t signal, uint32_t decimation );
+
+/**
+ * Returns the decimation of a signal
+ * @param signal    The signal
+ * @return          Control ticks between samples, 0 if unsubscribed
+ */
+uint32_t
+getTelemetryRate ( uint8_t signal );
+
+/**
+ * Returns true if any signal is subscribed. The text telemetry message is
+ * held off while binary frames are being sent
+ * @return True if any signal is subscribed
+ */
+bool
+isTelemetrySubscribed ( void );
+
+/**
+ * Returns the worst case link use of the current subscriptions
+ * @return The telemetry load in bytes per second
+ */
+uint32_t
+getTelemetryLoad ( void );
+
+/**
+ * Packs the signals due on this control tick into one frame and sends it.
+ * Sends nothing if no signal is due
+ * @param heli  The rig
+ * @param tick  The control tick
+ * @param lag   Ticks the control task is running behind SysTick
+ */
+void
+updateTelemetry ( const heli_t *heli, uint32_t tick, uint32_t lag );
+
+#endif /* TELEMETRY_H_ */
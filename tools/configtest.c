@@ -0,0 +1,279 @@
+/* @file    configtest.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Host check of the configuration record. Builds config.c with
+ *          CONFIG_RAM_EEPROM, then saves, loads, corrupts and clears the
+ *          record in the RAM stand-in
+ *
+ * Build:   gcc -O2 -Itools/stub -I. -o configtest tools/configtest.c
+ * Usage:   configtest
+ *
+ * config.c is included directly so the test can write damaged records
+ * into the RAM EEPROM. The modules the record is applied to are stubs that
+ * hold the value last set and count the calls, so a rejected record can be
+ * seen to apply nothing. Exits 1 if any check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define CONFIG_RAM_EEPROM
+#include "../config.c"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define CONFIG_FIELDS           ( sizeof ( config_t ) / sizeof ( uint32_t ))
+
+/**********************************************************
+ * Global variables
+ **********************************************************/
+
+static uint32_t g_checks = 0;
+static uint32_t g_failures = 0;
+static heli_t g_heli;
+
+// Module state the record is taken from and applied to
+static int32_t g_ground = 0;
+static float g_yaw_reference = 0;
+static int g_yaw = 0;
+static uint32_t g_filter_length = 0;
+static uint32_t g_telemetry_step = 0;
+static uint32_t g_applied = 0;          // Setter calls since the last reset
+
+/**********************************************************
+ * Stubs for the modules the record is applied to
+ **********************************************************/
+
+void
+setGround ( int32_t ground )
+{
+    g_ground = ground;
+    ++g_applied;
+}
+
+uint32_t
+getGround ( void )
+{
+    return g_ground;
+}
+
+void
+restoreYawReference ( float yaw )
+{
+    g_yaw_reference = yaw;
+    ++g_applied;
+}
+
+int
+getYaw ( void )
+{
+    return g_yaw;
+}
+
+void
+setFilterLength ( uint32_t length )
+{
+    g_filter_length = length;
+    ++g_applied;
+}
+
+uint32_t
+getFilterLength ( void )
+{
+    return g_filter_length;
+}
+
+void
+setTelemetryStep ( uint32_t step )
+{
+    g_telemetry_step = step;
+    ++g_applied;
+}
+
+uint32_t
+getTelemetryStep ( void )
+{
+    return g_telemetry_step;
+}
+
+/**
+ * Counts one check and reports it if it failed
+ * @param passed    Result of the check
+ * @param name      What was checked
+ * @param value     The value checked, printed on failure
+ */
+static void
+check ( bool passed, const char *name, long value )
+{
+    ++g_checks;
+
+    if ( !passed )
+    {
+        ++g_failures;
+        fprintf ( stderr, "FAIL %s (%ld)\n", name, value );
+    }
+}
+
+/**
+ * Sets the module state and gains a record is saved from
+ */
+static void
+setRig ( void )
+{
+    memset ( &g_heli, 0, sizeof ( g_heli ));
+    g_heli.main_pid.gains = ( gains_t ) { 0.8f, 0.01f, 0.01f };
+    g_heli.tail_pid.gains = ( gains_t ) { 1.5f, 0.02f, 0.3f };
+    g_ground = 1234;
+    g_yaw = -45;
+    g_filter_length = 16;
+    g_telemetry_step = 40;
+}
+
+/**
+ * Clears the module state and gains, as at power-up before a load
+ */
+static void
+clearRig ( void )
+{
+    memset ( &g_heli, 0, sizeof ( g_heli ));
+    g_ground = 0;
+    g_yaw_reference = 0;
+    g_filter_length = 0;
+    g_telemetry_step = 0;
+    g_applied = 0;
+}
+
+/**
+ * Reseals a record after a field was changed, so only that field is wrong
+ * @param config    The record
+ */
+static void
+sealRecord ( config_t *config )
+{
+    config->crc = calculateCRC (( uint8_t * ) config, sizeof ( *config ) - sizeof ( config->crc ));
+}
+
+/**
+ * Loads the stored record into a cleared rig and checks it was refused
+ * without applying anything
+ * @param name  What was checked
+ */
+static void
+checkRejected ( const char *name )
+{
+    bool loaded;
+
+    clearRig ();
+    loaded = loadConfig ( &g_heli );
+    check ( !loaded && g_applied == 0 && g_heli.main_pid.gains.proportional == 0, name, g_applied );
+}
+
+/**
+ * Saves a record and loads it back into a cleared rig
+ */
+static void
+testRoundTrip ( void )
+{
+    config_t config;
+    bool loaded;
+
+    check ( sizeof ( config_t ) <= sizeof ( g_ram_eeprom ), "record fits the RAM EEPROM", sizeof ( config_t ));
+
+    memset ( g_ram_eeprom, 0xFF, sizeof ( g_ram_eeprom ));
+    checkRejected ( "blank EEPROM refused" );
+
+    setRig ();
+    saveConfig ( &g_heli );
+    memcpy ( &config, g_ram_eeprom, sizeof ( config ));
+    check ( config.magic == CONFIG_MAGIC && config.version == CONFIG_VERSION, "record header", config.version );
+    check ( config.length == sizeof ( config ), "record length", config.length );
+    check ( config.crc == calculateCRC (( uint8_t * ) &config, sizeof ( config ) - sizeof ( config.crc )), "record CRC",
+            config.crc );
+
+    clearRig ();
+    loaded = loadConfig ( &g_heli );
+    check ( loaded, "saved record loaded", loaded );
+    check ( g_ground == 1234 && g_yaw_reference == -45, "calibration restored", g_ground );
+    check ( g_filter_length == 16 && g_telemetry_step == 40, "filter and telemetry restored", g_filter_length );
+    check ( g_heli.main_pid.gains.proportional == 0.8f && g_heli.main_pid.gains.integral == 0.01f
+            && g_heli.main_pid.gains.differential == 0.01f, "main gains restored", 0 );
+    check ( g_heli.tail_pid.gains.proportional == 1.5f && g_heli.tail_pid.gains.integral == 0.02f
+            && g_heli.tail_pid.gains.differential == 0.3f, "tail gains restored", 0 );
+}
+
+/**
+ * Damages a saved record in each way the load must catch: any flipped
+ * bit, another version, another length, a torn write and a clear
+ */
+static void
+testRejected ( void )
+{
+    config_t saved;
+    config_t config;
+    uint32_t field;
+    uint32_t bit;
+    uint32_t refused = 0;
+    uint32_t flips = 0;
+
+    setRig ();
+    saveConfig ( &g_heli );
+    memcpy ( &saved, g_ram_eeprom, sizeof ( saved ));
+
+    // Any single flipped bit, the CRC included
+    for ( field = 0; field < CONFIG_FIELDS; field++ )
+    {
+        for ( bit = 0; bit < 32; bit++ )
+        {
+            memcpy ( g_ram_eeprom, &saved, sizeof ( saved ));
+            g_ram_eeprom [ field ] ^= 1u << bit;
+            clearRig ();
+            refused += !loadConfig ( &g_heli ) && g_applied == 0;
+            ++flips;
+        }
+    }
+    check ( refused == flips, "corrupt records refused", flips - refused );
+
+    config = saved;
+    config.version = CONFIG_VERSION + 1;
+    sealRecord ( &config );
+    memcpy ( g_ram_eeprom, &config, sizeof ( config ));
+    checkRejected ( "other version refused" );
+
+    // A record from a build with fewer fields
+    config = saved;
+    config.length = sizeof ( config ) - sizeof ( uint32_t );
+    sealRecord ( &config );
+    memcpy ( g_ram_eeprom, &config, sizeof ( config ));
+    checkRejected ( "short record refused" );
+
+    // The power goes half way through programming over an erased EEPROM
+    memset ( g_ram_eeprom, 0xFF, sizeof ( g_ram_eeprom ));
+    memcpy ( g_ram_eeprom, &saved, sizeof ( saved ) / 2 );
+    checkRejected ( "torn record refused" );
+
+    memcpy ( g_ram_eeprom, &saved, sizeof ( saved ));
+    clearConfig ();
+    checkRejected ( "cleared record refused" );
+
+    // The clear leaves the rest of the record, a new save restores it
+    setRig ();
+    saveConfig ( &g_heli );
+    clearRig ();
+    check ( loadConfig ( &g_heli ), "record saved after a clear", 0 );
+}
+
+int
+main ( void )
+{
+    initConfig ();
+    testRoundTrip ();
+    testRejected ();
+
+    printf ( "%u checks, %u failed\n", g_checks, g_failures );
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,226 @@
+/* @file    controltime.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Host timing of the control task before and after the rotor
+ *          outputs were moved to the display task. Times the two scopes
+ *          the firmware profiles as PROF_MAIN_CONTROL and PROF_TAIL_CONTROL
+ *
+ * Build:   gcc -O2 -funsigned-char -Itools/stub -I. -o controltime tools/controltime.c control.c ustdlib.c -lm
+ * Usage:   controltime
+ *
+ * Before, each control law was followed by usprintf of its duty cycle and
+ * an OLEDStringDraw straight to the OLED. After, the scopes hold the
+ * control laws alone. OLEDStringDraw is a stub that counts what it is
+ * given, so the SPI transfer it starts on the rig is not in the host
+ * figures; the draw counts show how much of it left the control path.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "OrbitOLED/OrbitOLEDInterface.h"
+#include "utils/ustdlib.h"
+#include "../control.h"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define CONTROL_RATE_HZ         80      // Control task rate of the firmware
+#define MESSAGE_SIZE            24      // Message buffer of the old display helpers
+#define TICKS                   2000000 // Control ticks per round
+#define ROUNDS                  7       // Best of, the rounds interleave before and after
+
+// Control task scopes, as in profile.h
+enum scopes { SCOPE_MAIN = 0, SCOPE_TAIL, NUM_SCOPES };
+
+/**********************************************************
+ * Global variables
+ **********************************************************/
+
+static uint32_t g_draws = 0;            // OLEDStringDraw calls
+static uint32_t g_drawn = 0;            // Characters passed to OLEDStringDraw
+
+/**********************************************************
+ * Stubs
+ **********************************************************/
+
+void
+OLEDStringDraw ( char *str, uint32_t col, uint32_t row )
+{
+    ( void ) col;
+    ( void ) row;
+    ++g_draws;
+    g_drawn += strlen ( str );
+}
+
+/**
+ * Draws the main rotor duty cycle the way the control task did before the
+ * display task took it over
+ * @param duty  The duty cycle
+ */
+static void __attribute__ (( noinline ))
+oldDisplayPWMmain ( int duty )
+{
+    char cMessage [ MESSAGE_SIZE ];
+
+    usprintf ( cMessage, "Main output: %d ", ( unsigned long ) ( long ) duty );
+    OLEDStringDraw ( cMessage, 0, 0 );
+}
+
+/**
+ * Draws the tail rotor duty cycle the way the control task did before the
+ * display task took it over
+ * @param duty  The duty cycle
+ */
+static void __attribute__ (( noinline ))
+oldDisplayPWMtail ( int duty )
+{
+    char cMessage [ MESSAGE_SIZE ];
+
+    usprintf ( cMessage, "Tail output: %d ", ( unsigned long ) ( long ) duty );
+    OLEDStringDraw ( cMessage, 0, 1 );
+}
+
+/**
+ * Returns a monotonic time
+ * @return  Nanoseconds
+ */
+static double
+now ( void )
+{
+    struct timespec time;
+
+    clock_gettime ( CLOCK_MONOTONIC, &time );
+    return time.tv_sec * 1e9 + time.tv_nsec;
+}
+
+/**
+ * Moves the rig sensors along a slow oscillation about the targets, so the
+ * duty cycles and their text change from tick to tick
+ * @param heli  The rig
+ * @param tick  Control tick
+ */
+static void
+moveSensors ( heli_t *heli, uint32_t tick )
+{
+    heli->sensors.altitude = 50 + ( int32_t ) ( tick % 61 ) - 30;
+    heli->sensors.yaw = 90 + ( int32_t ) ( tick % 37 ) - 18;
+}
+
+/**
+ * Runs one round of control ticks, timing each scope
+ * @param old   True to draw the outputs inside the scopes as before
+ * @param ns    Lowest ns per tick of each scope so far, updated
+ */
+static void
+runRound ( bool old, double ns [ NUM_SCOPES ] )
+{
+    heli_t heli;
+    double total [ NUM_SCOPES ] = { 0 };
+    double start;
+    uint32_t tick;
+    uint32_t scope;
+
+    memset ( &heli, 0, sizeof ( heli ));
+    initControl ( &heli );
+    heli.setpoints.altitude = 50;
+    heli.setpoints.yaw = 90;
+
+    for ( tick = 0; tick < TICKS; tick++ )
+    {
+        moveSensors ( &heli, tick );
+
+        start = now ();
+        mainControl ( &heli );
+        if ( old )
+        {
+            oldDisplayPWMmain ( heli.actuators.main_duty );
+        }
+        total [ SCOPE_MAIN ] += now () - start;
+
+        start = now ();
+        tailControl ( &heli );
+        if ( old )
+        {
+            oldDisplayPWMtail ( heli.actuators.tail_duty );
+        }
+        total [ SCOPE_TAIL ] += now () - start;
+    }
+
+    for ( scope = 0; scope < NUM_SCOPES; scope++ )
+    {
+        double per_tick = total [ scope ] / TICKS;
+
+        ns [ scope ] = ( per_tick < ns [ scope ] ) ? per_tick : ns [ scope ];
+    }
+}
+
+/**
+ * Returns the cost of reading the clock twice, which every scope includes
+ * @return  Nanoseconds
+ */
+static double
+timerCost ( void )
+{
+    double best = INFINITY;
+    uint32_t round;
+    uint32_t i;
+
+    for ( round = 0; round < ROUNDS; round++ )
+    {
+        double total = 0;
+
+        for ( i = 0; i < TICKS; i++ )
+        {
+            double start = now ();
+            total += now () - start;
+        }
+        best = ( total / TICKS < best ) ? total / TICKS : best;
+    }
+    return best;
+}
+
+int
+main ( void )
+{
+    double before [ NUM_SCOPES ] = { INFINITY, INFINITY };
+    double after [ NUM_SCOPES ] = { INFINITY, INFINITY };
+    double timer = timerCost ();
+    uint32_t draws_before;
+    uint32_t drawn_before;
+    uint32_t round;
+
+    for ( round = 0; round < ROUNDS; round++ )
+    {
+        runRound ( true, before );
+        runRound ( false, after );
+    }
+
+    // The draws of one round of each
+    g_draws = g_drawn = 0;
+    runRound ( true, before );
+    draws_before = g_draws;
+    drawn_before = g_drawn;
+    g_draws = g_drawn = 0;
+    runRound ( false, after );
+
+    printf ( "ns per control tick, best of %u rounds of %u ticks, less %.1f ns of timer reads\n", ROUNDS, TICKS,
+             timer );
+    printf ( "%-20s %10s %10s\n", "scope", "before", "after" );
+    printf ( "%-20s %7.1f ns %7.1f ns\n", "PROF_MAIN_CONTROL", before [ SCOPE_MAIN ] - timer,
+             after [ SCOPE_MAIN ] - timer );
+    printf ( "%-20s %7.1f ns %7.1f ns\n", "PROF_TAIL_CONTROL", before [ SCOPE_TAIL ] - timer,
+             after [ SCOPE_TAIL ] - timer );
+    printf ( "%-20s %10.2f %10.2f\n", "OLED draws per tick", ( double ) draws_before / TICKS,
+             ( double ) g_draws / TICKS );
+    printf ( "%-20s %10.1f %10.1f\n", "characters per tick", ( double ) drawn_before / TICKS,
+             ( double ) g_drawn / TICKS );
+    printf ( "%-20s %10.0f %10.0f\n", "OLED draws per s", ( double ) draws_before / TICKS * CONTROL_RATE_HZ,
+             ( double ) g_draws / TICKS * CONTROL_RATE_HZ );
+    return 0;
+}
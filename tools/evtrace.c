@@ -0,0 +1,219 @@
+/* @file    evtrace.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Linux converter from the event trace sent by dumpEvents to
+ *          Chrome trace JSON
+ *
+ * Build:   gcc -O2 -o evtrace tools/evtrace.c
+ * Usage:   evtrace [-o out.json] dump.bin
+ *
+ * Load the output in chrome://tracing or ui.perfetto.dev. Each interrupt
+ * handler gets its own track so preemption of the main loop tasks shows
+ * as overlap, flight state changes, button events and triggers are instant
+ * events and the UART receive depth is a counter.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include "../events.h"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define MAIN_TID                1       // Track of the main loop tasks
+#define ISR_TID                 2       // Track of the first interrupt handler
+
+static const char *const g_isr_names [ NUM_EVT_ISRS ] = {
+    "SysTickIntHandler", "ADCIntHandler", "yawIntHandler", "refIntHandler", "UARTIntHandler"
+};
+
+static const char *const g_task_names [ NUM_EVT_TASKS ] = {
+    "control", "buttons", "display", "telemetry", "commands", "flushDisplay"
+};
+
+static const char *const g_state_names [] = { "landed", "Flying", "landing", "Calibration" };
+
+static const char *const g_button_names [] = { "UP", "DOWN", "LEFT", "RIGHT", "SWITCH", "SWITCH_2" };
+
+#define NAME( table, id )       (( id ) < sizeof ( table ) / sizeof ( table [ 0 ] ) ? table [ id ] : "?" )
+
+/**
+ * Scans forward to the trace header and reads it
+ * @param file      The dump
+ * @param header    Destination for the header
+ * @return          True if a header was found
+ */
+static bool
+readHeader ( FILE *file, eventHeader_t *header )
+{
+    uint32_t window = 0;
+    int byte;
+
+    // Skips any text telemetry sent ahead of the dump
+    while (( byte = fgetc ( file )) != EOF )
+    {
+        window = ( window >> 8 ) | (( uint32_t ) byte << 24 );
+
+        if ( window == EVENT_TRACE_MAGIC )
+        {
+            header->magic = window;
+            return fread ( &header->clock_hz, sizeof ( *header ) - sizeof ( header->magic ), 1, file ) == 1;
+        }
+    }
+    return false;
+}
+
+/**
+ * Writes one trace event
+ * @param out       Output file
+ * @param first     True for the first event, which takes no separator
+ * @param ph        Chrome trace phase
+ * @param name      Event name
+ * @param tid       Track
+ * @param time_us   Timestamp
+ */
+static void
+writeEvent ( FILE *out, bool first, char ph, const char *name, int tid, double time_us )
+{
+    fprintf ( out, "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"pid\":1,\"tid\":%d,\"ts\":%.3f",
+              first ? "" : ",", name, ph, tid, time_us );
+}
+
+int
+main ( int argc, char **argv )
+{
+    const char *out_path = NULL;
+    eventHeader_t header;
+    event_t *events;
+    int depth [ ISR_TID + NUM_EVT_ISRS ] = { 0 };
+    bool first = true;
+    uint32_t i;
+    FILE *file;
+    FILE *out = stdout;
+    int opt;
+
+    while (( opt = getopt ( argc, argv, "o:" )) != -1 )
+    {
+        switch ( opt )
+        {
+        case 'o':
+            out_path = optarg;
+            break;
+        default:
+            fprintf ( stderr, "usage: %s [-o out.json] dump.bin\n", argv [ 0 ] );
+            return 2;
+        }
+    }
+
+    if ( optind >= argc || !( file = fopen ( argv [ optind ], "rb" )))
+    {
+        fprintf ( stderr, "usage: %s [-o out.json] dump.bin\n", argv [ 0 ] );
+        return 2;
+    }
+
+    if ( !readHeader ( file, &header ) || header.clock_hz == 0 )
+    {
+        fprintf ( stderr, "no trace header found\n" );
+        return 1;
+    }
+    events = calloc ( header.count ? header.count : 1, sizeof ( event_t ));
+
+    if ( !events || fread ( events, sizeof ( event_t ), header.count, file ) != header.count )
+    {
+        fprintf ( stderr, "trace truncated, expected %u events\n", header.count );
+        return 1;
+    }
+    fclose ( file );
+
+    if ( out_path && !( out = fopen ( out_path, "w" )))
+    {
+        perror ( out_path );
+        return 1;
+    }
+
+    double us_per_cycle = 1e6 / header.clock_hz;
+    double time_us = 0;
+
+    fprintf ( out, "{\"traceEvents\":[" );
+
+    // Names the tracks
+    writeEvent ( out, first, 'M', "thread_name", MAIN_TID, 0 );
+    fprintf ( out, ",\"args\":{\"name\":\"main loop\"}}" );
+    first = false;
+
+    for ( i = 0; i < NUM_EVT_ISRS; i++ )
+    {
+        writeEvent ( out, first, 'M', "thread_name", ISR_TID + i, 0 );
+        fprintf ( out, ",\"args\":{\"name\":\"%s\"}}", g_isr_names [ i ] );
+    }
+
+    for ( i = 0; i < header.count; i++ )
+    {
+        const event_t *event = &events [ i ];
+
+        // Differences of the wrapping cycle count stay correct across a wrap
+        if ( i > 0 )
+        {
+            time_us += ( uint32_t ) ( event->time - events [ i - 1 ].time ) * us_per_cycle;
+        }
+
+        switch ( event->type )
+        {
+        case EVT_ISR_ENTER:
+        case EVT_ISR_EXIT:
+        case EVT_TASK_START:
+        case EVT_TASK_STOP:
+        {
+            bool isr = event->type == EVT_ISR_ENTER || event->type == EVT_ISR_EXIT;
+            bool begin = event->type == EVT_ISR_ENTER || event->type == EVT_TASK_START;
+            int tid = isr ? ISR_TID + event->id : MAIN_TID;
+
+            if ( tid >= ISR_TID + NUM_EVT_ISRS )
+            {
+                break;
+            }
+
+            // An end whose start was overwritten in the ring is dropped
+            if ( !begin && depth [ tid ] == 0 )
+            {
+                break;
+            }
+            depth [ tid ] += begin ? 1 : -1;
+            writeEvent ( out, first, begin ? 'B' : 'E',
+                         isr ? NAME ( g_isr_names, event->id ) : NAME ( g_task_names, event->id ), tid, time_us );
+            fprintf ( out, "}" );
+            break;
+        }
+        case EVT_STATE:
+            writeEvent ( out, first, 'i', NAME ( g_state_names, event->id ), MAIN_TID, time_us );
+            fprintf ( out, ",\"s\":\"g\",\"cat\":\"state\"}" );
+            break;
+        case EVT_BUTTON:
+            writeEvent ( out, first, 'i', NAME ( g_button_names, event->id ), MAIN_TID, time_us );
+            fprintf ( out, ",\"s\":\"t\",\"cat\":\"button\",\"args\":{\"pushed\":%u}}", event->arg );
+            break;
+        case EVT_UART_DEPTH:
+            writeEvent ( out, first, 'C', "UART receive depth", MAIN_TID, time_us );
+            fprintf ( out, ",\"args\":{\"bytes\":%u}}", event->arg );
+            break;
+        case EVT_TRIGGER:
+            writeEvent ( out, first, 'i', "trigger", MAIN_TID, time_us );
+            fprintf ( out, ",\"s\":\"g\"}" );
+            break;
+        }
+    }
+    fprintf ( out, "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped\":%u}}\n", header.dropped );
+
+    fprintf ( stderr, "events %u  dropped %u  span %.1f us\n", header.count, header.dropped, time_us );
+
+    if ( out != stdout )
+    {
+        fclose ( out );
+    }
+    free ( events );
+    return 0;
+}
@@ -0,0 +1,102 @@
+/* @file    fdrdump.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Linux converter from the flight recorder download sent by
+ *          dumpRecorder to CSV
+ *
+ * Build:   gcc -O2 -o fdrdump tools/fdrdump.c
+ * Usage:   fdrdump dump.bin > flight.csv
+ *
+ * Writes one line per control tick. Time restarts from zero at the first
+ * record and gaps in the sequence numbers (power cycles, missed control
+ * ticks, dropped records) are reported on stderr.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "../recorder.h"
+
+/**
+ * Scans forward to the download header and reads it
+ * @param file      The dump
+ * @param header    Destination for the header
+ * @return          True if a header was found
+ */
+static bool
+readHeader ( FILE *file, recorderHeader_t *header )
+{
+    uint32_t window = 0;
+    int byte;
+
+    // Skips any text telemetry sent ahead of the dump
+    while (( byte = fgetc ( file )) != EOF )
+    {
+        window = ( window >> 8 ) | (( uint32_t ) byte << 24 );
+
+        if ( window == RECORDER_MAGIC )
+        {
+            header->magic = window;
+            return fread ( &header->rate_hz, sizeof ( *header ) - sizeof ( header->magic ), 1, file ) == 1;
+        }
+    }
+    return false;
+}
+
+int
+main ( int argc, char **argv )
+{
+    recorderHeader_t header;
+    flightRecord_t record;
+    uint32_t first_seq = 0;
+    uint32_t last_seq = 0;
+    uint32_t gaps = 0;
+    uint32_t i;
+    FILE *file;
+
+    if ( argc != 2 || !( file = fopen ( argv [ 1 ], "rb" )))
+    {
+        fprintf ( stderr, "usage: %s dump.bin > flight.csv\n", argv [ 0 ] );
+        return 2;
+    }
+
+    if ( !readHeader ( file, &header ) || header.rate_hz == 0 )
+    {
+        fprintf ( stderr, "no recorder header found\n" );
+        return 1;
+    }
+
+    printf ( "time_s,seq,state,adc,alt,alt_target,yaw,yaw_target,"
+             "main_p,main_i,main_d,tail_p,tail_i,tail_d,main_duty,tail_duty\n" );
+
+    for ( i = 0; i < header.count; i++ )
+    {
+        if ( fread ( &record, sizeof ( record ), 1, file ) != 1 )
+        {
+            fprintf ( stderr, "download truncated after %u of %u records\n", i, header.count );
+            return 1;
+        }
+
+        if ( i == 0 )
+        {
+            first_seq = record.seq;
+        } else if ( record.seq != last_seq + 1 )
+        {
+            fprintf ( stderr, "gap of %u ticks before seq %u\n", record.seq - last_seq - 1, record.seq );
+            ++gaps;
+        }
+        last_seq = record.seq;
+
+        printf ( "%.4f,%u,%u,%u,%d,%d,%d,%d,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f\n",
+                 ( double ) ( record.seq - first_seq ) / header.rate_hz, record.seq, record.state,
+                 record.adc, record.altitude, record.alt_target, record.yaw, record.yaw_target,
+                 record.main_terms [ 0 ] / 100.0, record.main_terms [ 1 ] / 100.0, record.main_terms [ 2 ] / 100.0,
+                 record.tail_terms [ 0 ] / 100.0, record.tail_terms [ 1 ] / 100.0, record.tail_terms [ 2 ] / 100.0,
+                 record.main_duty / 100.0, record.tail_duty / 100.0 );
+    }
+    fclose ( file );
+
+    fprintf ( stderr, "records %u  gaps %u  dropped on target %u\n", header.count, gaps, header.dropped );
+    return 0;
+}
@@ -0,0 +1,272 @@
+/* @file    formattest.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Host check of format.c. Compares the formatters with snprintf on
+ *          random values and widths, then times them against usprintf for
+ *          the message shapes the display and telemetry build
+ *
+ * Build:   gcc -O2 -funsigned-char -Itools/stub -o formattest tools/formattest.c format.c ustdlib.c
+ * Usage:   formattest [-n cases] [-s seed]
+ *
+ * Every value is also checked with the widest width and a zero width, and
+ * a run of edge values goes first. Exits 1 if any check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "utils/ustdlib.h"
+#include "../format.h"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define DEFAULT_CASES           2000000
+#define MAX_WIDTH               14      // Past the longest int32_t, to check the padding
+#define TEXT_SIZE               64
+#define BENCH_CALLS             5000000
+#define FAILURES_SHOWN          10
+
+/**********************************************************
+ * Global variables
+ **********************************************************/
+
+static uint32_t g_checks = 0;
+static uint32_t g_failures = 0;
+static uint64_t g_random = 1;
+
+/**
+ * Counts one check and reports it if it failed
+ * @param passed    Result of the check
+ * @param name      What was checked
+ * @param ours      Formatter output
+ * @param theirs    snprintf output
+ */
+static void
+check ( bool passed, const char *name, const char *ours, const char *theirs )
+{
+    ++g_checks;
+
+    if ( !passed && ++g_failures <= FAILURES_SHOWN )
+    {
+        fprintf ( stderr, "FAIL %s: \"%s\", snprintf \"%s\"\n", name, ours, theirs );
+    }
+}
+
+/**
+ * Returns the next value of a splitmix64 generator
+ * @return  64 random bits
+ */
+static uint64_t
+nextRandom ( void )
+{
+    uint64_t z = ( g_random += 0x9E3779B97F4A7C15ULL );
+
+    z = ( z ^ ( z >> 30 )) * 0xBF58476D1CE4E5B9ULL;
+    z = ( z ^ ( z >> 27 )) * 0x94D049BB133111EBULL;
+    return z ^ ( z >> 31 );
+}
+
+/**
+ * Returns a random value with a random number of digits, so short values
+ * are as common as long ones
+ * @return  The value
+ */
+static int32_t
+randomValue ( void )
+{
+    uint64_t bits = nextRandom ();
+    int32_t value = ( int32_t ) bits;
+    uint32_t shift = ( bits >> 32 ) % 32;
+
+    return value >> shift;
+}
+
+/**
+ * Checks formatInt and formatFixed for one value and width, and that the
+ * returned end is the terminating null
+ * @param value     The value
+ * @param width     Field width
+ * @param decimals  Digits after the point for formatFixed
+ */
+static void
+checkValue ( int32_t value, uint32_t width, uint32_t decimals )
+{
+    char ours [ TEXT_SIZE ];
+    char theirs [ TEXT_SIZE ];
+    char number [ TEXT_SIZE ];
+    int64_t magnitude = ( value < 0 ) ? -( int64_t ) value : value;
+    int64_t scale = 1;
+    char *end;
+    uint32_t i;
+
+    end = formatInt ( ours, value, width );
+    snprintf ( theirs, sizeof ( theirs ), "%*d", ( int ) width, value );
+    check ( strcmp ( ours, theirs ) == 0 && end == ours + strlen ( ours ), "formatInt", ours, theirs );
+
+    for ( i = 0; i < decimals; i++ )
+    {
+        scale *= 10;
+    }
+
+    if ( decimals )
+    {
+        snprintf ( number, sizeof ( number ), "%s%lld.%0*lld", ( value < 0 ) ? "-" : "",
+                   ( long long ) ( magnitude / scale ), ( int ) decimals, ( long long ) ( magnitude % scale ));
+    } else
+    {
+        snprintf ( number, sizeof ( number ), "%d", value );
+    }
+    snprintf ( theirs, sizeof ( theirs ), "%*s", ( int ) width, number );
+    end = formatFixed ( ours, value, decimals, width );
+    check ( strcmp ( ours, theirs ) == 0 && end == ours + strlen ( ours ), "formatFixed", ours, theirs );
+}
+
+/**
+ * Checks the formatters on edge values, then on random values, widths and
+ * decimals
+ * @param cases Number of random values
+ */
+static void
+checkFormatters ( uint32_t cases )
+{
+    static const int32_t edges [] = { 0, 1, -1, 9, -9, 10, -10, 99, 100, -100, 999999999, 1000000000, -1000000000,
+                                      INT32_MAX, INT32_MIN, INT32_MIN + 1 };
+    char ours [ TEXT_SIZE ];
+    char *end;
+    uint32_t i;
+    uint32_t width;
+    uint32_t decimals;
+
+    for ( i = 0; i < sizeof ( edges ) / sizeof ( edges [ 0 ] ); i++ )
+    {
+        for ( width = 0; width <= MAX_WIDTH; width++ )
+        {
+            for ( decimals = 0; decimals <= 9; decimals++ )
+            {
+                checkValue ( edges [ i ], width, decimals );
+            }
+        }
+    }
+
+    while ( cases-- )
+    {
+        int32_t value = randomValue ();
+
+        checkValue ( value, nextRandom () % ( MAX_WIDTH + 1 ), nextRandom () % 10 );
+        checkValue ( value, 0, 0 );
+        checkValue ( value, MAX_WIDTH, 9 );
+    }
+
+    // Chained literals and strings
+    end = formatLiteral ( ours, "state " );
+    end = formatString ( end, "Flying" );
+    end = formatLiteral ( end, " yaw " );
+    end = formatInt ( end, -15, 0 );
+    formatLiteral ( end, "\r\n" );
+    check ( strcmp ( ours, "state Flying yaw -15\r\n" ) == 0, "chained message", ours, "state Flying yaw -15\r\n" );
+    end = formatString ( ours, "" );
+    check ( end == ours && *ours == '\0', "empty string", ours, "" );
+}
+
+/**
+ * Returns a monotonic time
+ * @return  Nanoseconds
+ */
+static double
+now ( void )
+{
+    struct timespec time;
+
+    clock_gettime ( CLOCK_MONOTONIC, &time );
+    return time.tv_sec * 1e9 + time.tv_nsec;
+}
+
+// Times BENCH_CALLS runs of a statement, leaving ns/op in the named variable
+#define BENCH( result, statement )                                      \
+    do                                                                  \
+    {                                                                   \
+        double start = now ();                                          \
+        for ( i = 0; i < BENCH_CALLS; i++ )                             \
+        {                                                               \
+            statement;                                                  \
+        }                                                               \
+        result = ( now () - start ) / BENCH_CALLS;                      \
+    } while ( 0 )
+
+/**
+ * Prints ns/op of usprintf and the formatters for the messages the firmware
+ * builds: the display yaw line, a telemetry line and the state report
+ */
+static void
+benchmark ( void )
+{
+    char text [ TEXT_SIZE ];
+    volatile char sink = 0;
+    double ours;
+    double theirs;
+    char *end;
+    uint32_t i;
+
+    printf ( "%-32s %10s %10s\n", "message", "usprintf", "format" );
+
+    BENCH ( theirs, usprintf ( text, "yaw: %4d ", ( unsigned long ) ( long ) ( i % 720 ) - 360 ); sink += text [ 6 ] );
+    BENCH ( ours, end = formatLiteral ( text, "yaw: " ); end = formatInt ( end, ( i % 720 ) - 360, 4 );
+            formatLiteral ( end, " " ); sink += text [ 6 ] );
+    printf ( "%-32s %7.1f ns %7.1f ns\n", "\"yaw: %4d \"", theirs, ours );
+
+    BENCH ( theirs, usprintf ( text, "Yaw: %2d [%2d] \r\n", ( unsigned long ) ( long ) ( i % 720 ) - 360,
+                               ( unsigned long ) ( long ) ( i % 48 ) * 15 - 360 ); sink += text [ 6 ] );
+    BENCH ( ours, end = formatLiteral ( text, "Yaw: " ); end = formatInt ( end, ( i % 720 ) - 360, 2 );
+            end = formatLiteral ( end, " [" ); end = formatInt ( end, ( i % 48 ) * 15 - 360, 2 );
+            formatLiteral ( end, "] \r\n" ); sink += text [ 6 ] );
+    printf ( "%-32s %7.1f ns %7.1f ns\n", "\"Yaw: %2d [%2d] \\r\\n\"", theirs, ours );
+
+    BENCH ( theirs, usprintf ( text, "state %s alt %d yaw %d main %d tail %d\r\n", "Flying",
+                               ( unsigned long ) ( i % 101 ), ( unsigned long ) ( long ) ( i % 720 ) - 360,
+                               ( unsigned long ) ( i % 98 ), ( unsigned long ) ( i % 71 )); sink += text [ 6 ] );
+    BENCH ( ours, end = formatLiteral ( text, "state " ); end = formatString ( end, "Flying" );
+            end = formatLiteral ( end, " alt " ); end = formatInt ( end, i % 101, 0 );
+            end = formatLiteral ( end, " yaw " ); end = formatInt ( end, ( i % 720 ) - 360, 0 );
+            end = formatLiteral ( end, " main " ); end = formatInt ( end, i % 98, 0 );
+            end = formatLiteral ( end, " tail " ); end = formatInt ( end, i % 71, 0 );
+            formatLiteral ( end, "\r\n" ); sink += text [ 6 ] );
+    printf ( "%-32s %7.1f ns %7.1f ns\n", "state report", theirs, ours );
+}
+
+int
+main ( int argc, char **argv )
+{
+    uint32_t cases = DEFAULT_CASES;
+    uint64_t seed;
+    int opt;
+
+    while (( opt = getopt ( argc, argv, "n:s:" )) != -1 )
+    {
+        switch ( opt )
+        {
+        case 'n':
+            cases = strtoul ( optarg, NULL, 10 );
+            break;
+        case 's':
+            g_random = strtoull ( optarg, NULL, 10 );
+            break;
+        default:
+            fprintf ( stderr, "usage: %s [-n cases] [-s seed]\n", argv [ 0 ] );
+            return 2;
+        }
+    }
+
+    seed = g_random;
+    checkFormatters ( cases );
+    printf ( "%u values, seed %llu: %u checks, %u failed\n\n", cases, ( unsigned long long ) seed, g_checks,
+             g_failures );
+
+    benchmark ();
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,428 @@
+/* @file    gainsweep.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Linux PID gain sweep against the simulated rig. Flies every
+ *          candidate gain set of one loop over the same Monte Carlo rigs in
+ *          parallel, scores it by its step metrics and prints the Pareto
+ *          front and a gain table ready to flash
+ *
+ * Build:   gcc -O2 -pthread -o gainsweep tools/gainsweep.c tools/rigsim.c control.c flight.c shape.c metrics.c format.c -lm
+ * Usage:   gainsweep [-l main|tail] [-p lo:hi:n] [-i lo:hi:n] [-d lo:hi:n] [-r count] [-n rigs]
+ *                    [-j threads] [-s seed] [-a noise] [-m spread] [-b sag] [-o overshoot]
+ *
+ * Candidates form a grid of n values per gain from lo to hi, or with -r
+ * count random points inside the same ranges. A single value fixes a gain.
+ * The other loop keeps the firmware gains. Every candidate flies the same
+ * rigs, so differences come from the gains and not the draw.
+ * A candidate is scored by its mean settling time, its mean overshoot and
+ * its mean IAE, all on the swept loop. The front holds the candidates that
+ * settled on every rig and that no other such candidate beats on all three.
+ * The gain table is the quickest settling front candidate within the
+ * overshoot limit.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "../control.h"
+#include "rigsim.h"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define MAX_THREADS             256
+#define MAX_CANDIDATES          1000000
+#define RANDOM_STREAM           0xA0761D6478BD642FULL   // Keeps candidate draws apart from the rig draws
+
+/**********************************************************
+ * Type definitions
+ **********************************************************/
+
+// Values of one gain to sweep
+typedef struct {
+    double low;
+    double high;
+    uint32_t steps;                     // Grid values from low to high
+} range_t;
+
+// One gain set and its score
+typedef struct {
+    gains_t gains;
+    uint32_t settled;                   // Rigs that settled
+    double settle_ms;                   // Mean settling time, unsettled rigs count as the run
+    double overshoot;                   // Mean overshoot, percent
+    double iae;                         // Mean IAE
+    bool front;                         // Set if on the Pareto front
+} candidate_t;
+
+// Work shared by the workers, read only but for the claim counter and
+// each candidate's own score
+typedef struct {
+    bool tail;                          // True to sweep the tail loop
+    uint32_t rigs;                      // Rigs flown per candidate
+    rigSpread_t spread;
+    candidate_t *candidates;
+    uint32_t count;
+    uint32_t next;                      // Next unclaimed candidate, claimed atomically
+} sweepState_t;
+
+/**
+ * Reads a range as lo:hi:n, or a single fixed value
+ * @param text  The option text
+ * @param range Destination for the range
+ * @return      True if the text was a valid range
+ */
+static bool
+parseRange ( const char *text, range_t *range )
+{
+    char end;
+
+    if ( sscanf ( text, "%lf:%lf:%u%c", &range->low, &range->high, &range->steps, &end ) == 3 )
+    {
+        return range->steps > 0 && range->high >= range->low;
+    }
+
+    if ( sscanf ( text, "%lf%c", &range->low, &end ) == 1 )
+    {
+        range->high = range->low;
+        range->steps = 1;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Returns one grid value of a range
+ * @param range The range
+ * @param step  Grid index, below range->steps
+ * @return      The value
+ */
+static double
+gridValue ( const range_t *range, uint32_t step )
+{
+    return ( range->steps > 1 ) ? range->low + ( range->high - range->low ) * step / ( range->steps - 1 ) : range->low;
+}
+
+/**
+ * Flies every rig with one candidate's gains and scores it
+ * @param sweep     The sweep
+ * @param candidate The candidate
+ */
+static void
+scoreCandidate ( const sweepState_t *sweep, candidate_t *candidate )
+{
+    const gains_t *main = sweep->tail ? NULL : &candidate->gains;
+    const gains_t *tail = sweep->tail ? &candidate->gains : NULL;
+    uint32_t settle_total = 0;
+    uint32_t overshoot_total = 0;
+    double iae_total = 0;
+    uint32_t rig;
+
+    candidate->settled = 0;
+
+    for ( rig = 0; rig < sweep->rigs; rig++ )
+    {
+        rigParams_t params;
+        rigResult_t result;
+        uint64_t random;
+        const stepMetrics_t *metrics = sweep->tail ? &result.yaw : &result.alt;
+
+        drawRig ( &sweep->spread, rig, &params, &random );
+        flyRig ( &params, main, tail, &random, &result );
+
+        candidate->settled += metrics->settled;
+        settle_total += metrics->settled ? metrics->settle_ms : SIM_SECONDS * 1000;
+        overshoot_total += metrics->overshoot;
+        iae_total += metrics->iae;
+    }
+    candidate->settle_ms = ( double ) settle_total / sweep->rigs;
+    candidate->overshoot = ( double ) overshoot_total / sweep->rigs;
+    candidate->iae = iae_total / sweep->rigs;
+}
+
+/**
+ * Claims candidates one at a time until none are left. Each one flies
+ * every rig, so a single candidate is already a large enough unit of work
+ * @param arg   The sweep
+ * @return      NULL
+ */
+static void *
+worker ( void *arg )
+{
+    sweepState_t *sweep = arg;
+    uint32_t index;
+
+    while (( index = __atomic_fetch_add ( &sweep->next, 1, __ATOMIC_RELAXED )) < sweep->count )
+    {
+        scoreCandidate ( sweep, &sweep->candidates [ index ] );
+    }
+    return NULL;
+}
+
+/**
+ * Returns true if one candidate is no worse than another on every score
+ * and better on at least one
+ * @param a The candidate that may dominate
+ * @param b The candidate that may be dominated
+ * @return  True if a dominates b
+ */
+static bool
+dominates ( const candidate_t *a, const candidate_t *b )
+{
+    return a->settle_ms <= b->settle_ms && a->overshoot <= b->overshoot && a->iae <= b->iae
+            && ( a->settle_ms < b->settle_ms || a->overshoot < b->overshoot || a->iae < b->iae );
+}
+
+/**
+ * Orders candidates by mean settling time, then overshoot, then IAE for qsort
+ */
+static int
+compareScores ( const void *a, const void *b )
+{
+    const candidate_t *x = a;
+    const candidate_t *y = b;
+
+    if ( x->settle_ms != y->settle_ms )
+    {
+        return ( x->settle_ms > y->settle_ms ) - ( x->settle_ms < y->settle_ms );
+    }
+
+    if ( x->overshoot != y->overshoot )
+    {
+        return ( x->overshoot > y->overshoot ) - ( x->overshoot < y->overshoot );
+    }
+    return ( x->iae > y->iae ) - ( x->iae < y->iae );
+}
+
+/**
+ * Prints one candidate as a row of the front
+ * @param candidate The candidate
+ * @param rigs      Rigs flown per candidate
+ */
+static void
+printCandidate ( const candidate_t *candidate, uint32_t rigs )
+{
+    printf ( "%9.4f %9.4f %9.4f %7.1f %% %10.0f %11.1f %10.0f\n", candidate->gains.proportional,
+             candidate->gains.integral, candidate->gains.differential, 100.0 * candidate->settled / rigs,
+             candidate->settle_ms, candidate->overshoot, candidate->iae );
+}
+
+int
+main ( int argc, char **argv )
+{
+    sweepState_t sweep = { false, 32, { 1, 1.0, 0.1, 0.15 }, NULL, 0, 0 };
+    range_t ranges [ 3 ] = { { 0.2, 2.0, 10 }, { 0.0, 0.05, 6 }, { 0.0, 0.5, 6 } };
+    pthread_t threads [ MAX_THREADS ];
+    long threads_wanted = sysconf ( _SC_NPROCESSORS_ONLN );
+    uint32_t random_count = 0;
+    double max_overshoot = 30;
+    const candidate_t *chosen = NULL;
+    heli_t defaults;
+    candidate_t firmware;
+    uint32_t *front_index;             // Candidates on the front, in score order
+    uint32_t front = 0;
+    uint64_t count;
+    long started;
+    int error;
+    uint32_t i;
+    uint32_t j;
+    int opt;
+
+    while (( opt = getopt ( argc, argv, "l:p:i:d:r:n:j:s:a:m:b:o:" )) != -1 )
+    {
+        bool valid = true;
+
+        switch ( opt )
+        {
+        case 'l':
+            sweep.tail = strcmp ( optarg, "tail" ) == 0;
+            valid = sweep.tail || strcmp ( optarg, "main" ) == 0;
+            break;
+        case 'p':
+            valid = parseRange ( optarg, &ranges [ 0 ] );
+            break;
+        case 'i':
+            valid = parseRange ( optarg, &ranges [ 1 ] );
+            break;
+        case 'd':
+            valid = parseRange ( optarg, &ranges [ 2 ] );
+            break;
+        case 'r':
+            random_count = strtoul ( optarg, NULL, 10 );
+            valid = random_count > 0 && random_count <= MAX_CANDIDATES;
+            break;
+        case 'n':
+            sweep.rigs = strtoul ( optarg, NULL, 10 );
+            valid = sweep.rigs > 0;
+            break;
+        case 'j':
+            threads_wanted = strtol ( optarg, NULL, 10 );
+            break;
+        case 's':
+            sweep.spread.seed = strtoull ( optarg, NULL, 10 );
+            break;
+        case 'a':
+            sweep.spread.alt_noise = strtod ( optarg, NULL );
+            break;
+        case 'm':
+            sweep.spread.motor_spread = strtod ( optarg, NULL );
+            break;
+        case 'b':
+            sweep.spread.max_sag = strtod ( optarg, NULL );
+            break;
+        case 'o':
+            max_overshoot = strtod ( optarg, NULL );
+            break;
+        default:
+            valid = false;
+            break;
+        }
+
+        if ( !valid )
+        {
+            fprintf ( stderr, "usage: %s [-l main|tail] [-p lo:hi:n] [-i lo:hi:n] [-d lo:hi:n] [-r count] [-n rigs]\n"
+                      "       [-j threads] [-s seed] [-a noise] [-m spread] [-b sag] [-o overshoot]\n", argv [ 0 ] );
+            return 2;
+        }
+    }
+
+    count = random_count ? random_count : ( uint64_t ) ranges [ 0 ].steps * ranges [ 1 ].steps * ranges [ 2 ].steps;
+
+    if ( count > MAX_CANDIDATES || !( sweep.candidates = calloc ( count, sizeof ( candidate_t )))
+            || !( front_index = malloc ( count * sizeof ( uint32_t ))))
+    {
+        fprintf ( stderr, "%llu candidates is too many\n", ( unsigned long long ) count );
+        return 2;
+    }
+    sweep.count = count;
+
+    // Candidates are laid out before any are flown, so the run does not
+    // depend on the number of threads
+    if ( random_count )
+    {
+        uint64_t random = sweep.spread.seed ^ RANDOM_STREAM;
+
+        for ( i = 0; i < sweep.count; i++ )
+        {
+            gains_t *gains = &sweep.candidates [ i ].gains;
+
+            gains->proportional = ranges [ 0 ].low + ( ranges [ 0 ].high - ranges [ 0 ].low ) * uniform ( &random );
+            gains->integral = ranges [ 1 ].low + ( ranges [ 1 ].high - ranges [ 1 ].low ) * uniform ( &random );
+            gains->differential = ranges [ 2 ].low + ( ranges [ 2 ].high - ranges [ 2 ].low ) * uniform ( &random );
+        }
+    }
+    else
+    {
+        for ( i = 0; i < sweep.count; i++ )
+        {
+            gains_t *gains = &sweep.candidates [ i ].gains;
+
+            gains->proportional = gridValue ( &ranges [ 0 ], i / ( ranges [ 1 ].steps * ranges [ 2 ].steps ));
+            gains->integral = gridValue ( &ranges [ 1 ], i / ranges [ 2 ].steps % ranges [ 1 ].steps );
+            gains->differential = gridValue ( &ranges [ 2 ], i % ranges [ 2 ].steps );
+        }
+    }
+
+    if ( threads_wanted < 1 )
+    {
+        threads_wanted = 1;
+    }
+
+    if ( threads_wanted > MAX_THREADS )
+    {
+        threads_wanted = MAX_THREADS;
+    }
+
+    for ( started = 0; started < threads_wanted; started++ )
+    {
+        if (( error = pthread_create ( &threads [ started ], NULL, worker, &sweep )) != 0 )
+        {
+            fprintf ( stderr, "thread %ld not started: %s\n", started, strerror ( error ));
+            break;
+        }
+    }
+
+    // The threads that did start share the work, with none this one does it
+    if ( started == 0 )
+    {
+        worker ( &sweep );
+    }
+
+    for ( i = 0; i < started; i++ )
+    {
+        pthread_join ( threads [ i ], NULL );
+    }
+
+    // The firmware gains, scored on the same rigs for comparison
+    initControl ( &defaults );
+    firmware.gains = sweep.tail ? defaults.tail_pid.gains : defaults.main_pid.gains;
+    scoreCandidate ( &sweep, &firmware );
+
+    // Sorted by settle, then overshoot, then IAE, a candidate can only be
+    // dominated by one before it, and only needs checking against the front
+    // so far: anything dominating it is itself dominated by a front member.
+    // The front stays small, so this is near linear in the candidates
+    qsort ( sweep.candidates, sweep.count, sizeof ( candidate_t ), compareScores );
+
+    for ( i = 0; i < sweep.count; i++ )
+    {
+        candidate_t *candidate = &sweep.candidates [ i ];
+
+        // Only gains that settle on every rig are worth flying
+        candidate->front = candidate->settled == sweep.rigs;
+
+        for ( j = 0; j < front && candidate->front; j++ )
+        {
+            candidate->front = !dominates ( &sweep.candidates [ front_index [ j ]], candidate );
+        }
+
+        if ( candidate->front )
+        {
+            front_index [ front++ ] = i;
+        }
+    }
+
+    printf ( "%s loop, %u %s candidates of %u rigs on %ld threads, seed %llu, noise %.2f %%, motor spread +-%.0f %%, "
+             "sag up to %.0f %%\n", sweep.tail ? "tail" : "main", sweep.count, random_count ? "random" : "grid",
+             sweep.rigs, started ? started : 1, ( unsigned long long ) sweep.spread.seed, sweep.spread.alt_noise,
+             sweep.spread.motor_spread * 100, sweep.spread.max_sag * 100 );
+    printf ( "%9s %9s %9s %9s %10s %11s %10s\n", "p", "i", "d", "settled", "settle ms", "overshoot %", "iae" );
+
+    for ( i = 0; i < front; i++ )
+    {
+        const candidate_t *candidate = &sweep.candidates [ front_index [ i ]];
+
+        printCandidate ( candidate, sweep.rigs );
+
+        if ( !chosen && candidate->overshoot <= max_overshoot )
+        {
+            chosen = candidate;
+        }
+    }
+    printf ( "%u of %u candidates on the front, firmware gains:\n", front, sweep.count );
+    printCandidate ( &firmware, sweep.rigs );
+
+    if ( !chosen )
+    {
+        printf ( "no candidate settled on every rig within %.0f %% overshoot\n", max_overshoot );
+        free ( front_index );
+        free ( sweep.candidates );
+        return 1;
+    }
+
+    printf ( "\n// control.c\n" );
+    printf ( "#define %s_PROPORTIONAL_GAIN  %.4g\n", sweep.tail ? "TAIL" : "MAIN", chosen->gains.proportional );
+    printf ( "#define %s_INTEGRAL_GAIN      %.4g\n", sweep.tail ? "TAIL" : "MAIN", chosen->gains.integral );
+    printf ( "#define %s_DIFFERENTIAL_GAIN  %.4g\n", sweep.tail ? "TAIL" : "MAIN", chosen->gains.differential );
+    printf ( "\n// or over UART, kept in the EEPROM\n" );
+    printf ( "gain %s %.4g %.4g %.4g\nsave\n", sweep.tail ? "tail" : "main", chosen->gains.proportional,
+             chosen->gains.integral, chosen->gains.differential );
+    free ( front_index );
+    free ( sweep.candidates );
+    return 0;
+}
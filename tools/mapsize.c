@@ -0,0 +1,242 @@
+/* @file    mapsize.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Linux size report from the TI linker map file. Run as a post-build
+ *          step so every build lists the flash and RAM each object takes
+ *          and fails if the heap allocator was linked in
+ *
+ * Build:   gcc -O2 -o mapsize tools/mapsize.c
+ * Usage:   mapsize Debug/heli.map
+ *
+ * Reads the SECTION ALLOCATION MAP. Code and constants count as flash,
+ * .data, .bss and .sysmem as RAM (.data is also copied from flash). The
+ * .stack is reported apart. Exits 1 if malloc, calloc, realloc or free is
+ * linked or a heap is reserved, so a reintroduced allocation breaks the build.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define LINE_SIZE               512     // Longest map line read
+#define NAME_SIZE               64      // Longest object name kept
+#define MAX_OBJECTS             128     // Objects the report can list
+
+/**********************************************************
+ * Type definitions
+ **********************************************************/
+
+typedef struct {
+    char name [ NAME_SIZE ];
+    uint32_t flash;                     // Code and constants, bytes
+    uint32_t ram;                       // Initialized and zeroed data, bytes
+} objectSize_t;
+
+/**********************************************************
+ * Global variables
+ **********************************************************/
+
+static objectSize_t g_objects [ MAX_OBJECTS ];
+static uint32_t g_object_count = 0;
+
+// Allocator entry points of the TI run time library
+static const char *const g_allocators [] = { ":malloc)", ":calloc)", ":realloc)", ":free)" };
+
+/**
+ * Finds an object in the report, adding it if new
+ * @param name  Object or library member name
+ * @return      The object, NULL if the report is full
+ */
+static objectSize_t *
+findObject ( const char *name )
+{
+    uint32_t i;
+
+    for ( i = 0; i < g_object_count; i++ )
+    {
+        if ( strcmp ( g_objects [ i ].name, name ) == 0 )
+        {
+            return &g_objects [ i ];
+        }
+    }
+
+    if ( g_object_count == MAX_OBJECTS )
+    {
+        return NULL;
+    }
+    snprintf ( g_objects [ g_object_count ].name, NAME_SIZE, "%s", name );
+    return &g_objects [ g_object_count++ ];
+}
+
+/**
+ * Returns true if an output section is placed in RAM
+ * @param section   Output section name
+ * @return          True for .data, .bss and .sysmem
+ */
+static bool
+isRamSection ( const char *section )
+{
+    return strcmp ( section, ".data" ) == 0 || strcmp ( section, ".bss" ) == 0
+            || strcmp ( section, ".sysmem" ) == 0;
+}
+
+/**
+ * Takes the object name from an input section line, the word ahead of the
+ * "(section)" part, or "common" for uninitialized globals with no object
+ * @param text  Input section text after the origin and length
+ * @param name  Destination, NAME_SIZE bytes
+ */
+static void
+parseObject ( const char *text, char *name )
+{
+    const char *paren = strchr ( text, '(' );
+    const char *start;
+    const char *end;
+
+    if ( !paren )
+    {
+        snprintf ( name, NAME_SIZE, "other" );
+        return;
+    }
+
+    for ( end = paren; end > text && end [ -1 ] == ' '; end-- )
+    {
+    }
+
+    for ( start = end; start > text && start [ -1 ] != ' '; start-- )
+    {
+    }
+
+    if ( start == end )
+    {
+        snprintf ( name, NAME_SIZE, "common" );
+    }
+    else
+    {
+        snprintf ( name, NAME_SIZE, "%.*s", ( int ) ( end - start ), start );
+    }
+}
+
+int
+main ( int argc, char **argv )
+{
+    char line [ LINE_SIZE ];
+    char section [ NAME_SIZE ] = "";
+    char name [ NAME_SIZE ];
+    objectSize_t *object;
+    bool in_map = false;
+    bool allocator = false;
+    uint32_t flash = 0;
+    uint32_t ram = 0;
+    uint32_t stack = 0;
+    uint32_t heap = 0;
+    uint32_t i;
+    FILE *file;
+
+    if ( argc != 2 || !( file = fopen ( argv [ 1 ], "r" )))
+    {
+        fprintf ( stderr, "usage: %s project.map\n", argv [ 0 ] );
+        return 2;
+    }
+
+    while ( fgets ( line, sizeof ( line ), file ))
+    {
+        unsigned origin;
+        unsigned length;
+        unsigned page;
+        int used;
+
+        if ( strncmp ( line, "SECTION ALLOCATION MAP", 22 ) == 0 )
+        {
+            in_map = true;
+            continue;
+        }
+
+        if ( !in_map )
+        {
+            continue;
+        }
+
+        if ( strncmp ( line, "MODULE SUMMARY", 14 ) == 0 || strncmp ( line, "GLOBAL SYMBOLS", 14 ) == 0 )
+        {
+            break;
+        }
+
+        // Output section: name, page, origin, length
+        if ( line [ 0 ] == '.' && sscanf ( line, "%63s %u %x %x", section, &page, &origin, &length ) == 4 )
+        {
+            if ( strcmp ( section, ".stack" ) == 0 )
+            {
+                stack = length;
+            }
+            else if ( strcmp ( section, ".sysmem" ) == 0 )
+            {
+                heap = length;
+            }
+            continue;
+        }
+
+        // Input section: origin, length, object (section)
+        if ( line [ 0 ] != ' ' || sscanf ( line, " %x %x %n", &origin, &length, &used ) != 2
+                || section [ 0 ] == '\0' || strcmp ( section, ".stack" ) == 0 )
+        {
+            continue;
+        }
+
+        for ( i = 0; i < sizeof ( g_allocators ) / sizeof ( g_allocators [ 0 ] ); i++ )
+        {
+            if ( strstr ( line + used, g_allocators [ i ] ))
+            {
+                fprintf ( stderr, "heap allocator linked: %s", line + used );
+                allocator = true;
+            }
+        }
+
+        parseObject ( line + used, name );
+        object = findObject ( name );
+
+        if ( !object )
+        {
+            continue;
+        }
+
+        if ( isRamSection ( section ))
+        {
+            object->ram += length;
+            ram += length;
+        }
+        else
+        {
+            object->flash += length;
+            flash += length;
+        }
+    }
+    fclose ( file );
+
+    if ( !in_map )
+    {
+        fprintf ( stderr, "no section allocation map in %s\n", argv [ 1 ] );
+        return 2;
+    }
+
+    printf ( "%-32s %8s %8s\n", "object", "flash", "ram" );
+
+    for ( i = 0; i < g_object_count; i++ )
+    {
+        printf ( "%-32s %8u %8u\n", g_objects [ i ].name, g_objects [ i ].flash, g_objects [ i ].ram );
+    }
+    printf ( "%-32s %8u %8u\n", "total", flash, ram );
+    printf ( "%-32s %8s %8u\n", "stack", "", stack );
+
+    if ( heap )
+    {
+        fprintf ( stderr, "heap of %u bytes reserved, link with -heap 0\n", heap );
+    }
+    return ( allocator || heap ) ? 1 : 0;
+}
@@ -0,0 +1,283 @@
+/* @file    montecarlo.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Linux Monte Carlo run of the flight controller against many
+ *          simulated rigs in parallel. Each rig has its own heli_t, plant,
+ *          sensor noise, motor variation and battery sag, and runs the same
+ *          control laws and step metrics as the firmware
+ *
+ * Build:   gcc -O2 -pthread -o montecarlo tools/montecarlo.c tools/rigsim.c control.c flight.c shape.c metrics.c format.c -lm
+ * Usage:   montecarlo [-n rigs] [-j threads] [-s seed] [-a noise] [-m spread] [-b sag]
+ *
+ * Every rig takes off through the firmware flight state machine, seeks
+ * the yaw reference, settles in a hover at ALT_START percent, then steps
+ * to ALT_TARGET percent while turning to YAW_TARGET degrees and lands. The
+ * seek and landing times and the step metrics of both loops are collected.
+ * Each rig also seeks again with the stepped search the constant-rate
+ * sweep replaced, to compare the time to the reference.
+ * Rig parameters come from a generator seeded by the seed and the rig
+ * number, so a run gives the same results with any number of threads.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "rigsim.h"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define CHUNK_RIGS              64      // Rigs a worker claims at a time
+#define MAX_THREADS             256
+
+/**********************************************************
+ * Type definitions
+ **********************************************************/
+
+// Work shared by the workers, read only but for the claim counter
+typedef struct {
+    uint32_t rigs;
+    rigSpread_t spread;
+    rigResult_t *results;
+    rigResult_t *stepped;               // Seek of the same rigs with the old stepped search
+    uint32_t next;                      // Next unclaimed rig, claimed atomically
+} runState_t;
+
+/**
+ * Claims chunks of rigs until none are left. Rigs cost about the same, so
+ * claiming small chunks from one counter balances the load as well as
+ * per-thread queues with stealing would
+ * @param arg   The run state
+ * @return      NULL
+ */
+static void *
+worker ( void *arg )
+{
+    runState_t *run = arg;
+    uint32_t first;
+
+    while (( first = __atomic_fetch_add ( &run->next, CHUNK_RIGS, __ATOMIC_RELAXED )) < run->rigs )
+    {
+        uint32_t last = ( first + CHUNK_RIGS < run->rigs ) ? first + CHUNK_RIGS : run->rigs;
+        uint32_t rig;
+
+        for ( rig = first; rig < last; rig++ )
+        {
+            rigParams_t params;
+            uint64_t random;
+
+            drawRig ( &run->spread, rig, &params, &random );
+            flyRig ( &params, NULL, NULL, &random, &run->results [ rig ] );
+
+            // The same rig again, seeking with the search the sweep replaced
+            drawRig ( &run->spread, rig, &params, &random );
+            params.seek = SEEK_STEPPED;
+            seekRig ( &params, &random, &run->stepped [ rig ] );
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Orders two values for qsort
+ */
+static int
+compareValues ( const void *a, const void *b )
+{
+    double x = *( const double * ) a;
+    double y = *( const double * ) b;
+
+    return ( x > y ) - ( x < y );
+}
+
+/**
+ * Prints the median, 90th, 99th percentile and worst of one metric
+ * @param name      Metric name
+ * @param values    One value per rig, sorted in place
+ * @param count     Number of values
+ */
+static void
+printSpread ( const char *name, double *values, uint32_t count )
+{
+    qsort ( values, count, sizeof ( double ), compareValues );
+    printf ( "  %-12s p50 %8.1f  p90 %8.1f  p99 %8.1f  max %8.1f\n", name, values [ count / 2 ],
+             values [ ( uint64_t ) count * 90 / 100 ], values [ ( uint64_t ) count * 99 / 100 ], values [ count - 1 ] );
+}
+
+/**
+ * Prints the spread of every metric of one loop over all rigs
+ * @param name      Loop name
+ * @param results   All rig results
+ * @param count     Number of rigs
+ * @param yaw       True for the yaw loop, false for altitude
+ */
+static void
+printLoop ( const char *name, const rigResult_t *results, uint32_t count, bool yaw )
+{
+    double *values = malloc ( count * sizeof ( double ));
+    uint32_t settled = 0;
+    uint32_t i;
+
+    for ( i = 0; i < count; i++ )
+    {
+        settled += ( yaw ? results [ i ].yaw : results [ i ].alt ).settled;
+    }
+    printf ( "%s: %u of %u settled (%.2f %%)\n", name, settled, count, 100.0 * settled / count );
+
+#define SPREAD( label, expr )                                                           \
+    for ( i = 0; i < count; i++ )                                                       \
+    {                                                                                   \
+        const stepMetrics_t *m = yaw ? &results [ i ].yaw : &results [ i ].alt;         \
+        values [ i ] = ( expr );                                                        \
+    }                                                                                   \
+    printSpread ( label, values, count )
+
+    SPREAD ( "rise ms", m->rise_ms );
+    SPREAD ( "overshoot %", m->overshoot );
+    SPREAD ( "settle ms", m->settle_ms );
+    SPREAD ( "|ss error|", abs ( m->ss_error ));
+    SPREAD ( "iae", m->iae );
+#undef SPREAD
+    free ( values );
+}
+
+/**
+ * Prints how many rigs found the yaw reference and the spread of their
+ * seek times
+ * @param name      Search name
+ * @param results   All rig results
+ * @param count     Number of rigs
+ */
+static void
+printSeek ( const char *name, const rigResult_t *results, uint32_t count )
+{
+    double *values = malloc ( count * sizeof ( double ));
+    uint32_t referenced = 0;
+    uint32_t i;
+
+    for ( i = 0; i < count; i++ )
+    {
+        referenced += results [ i ].referenced;
+        values [ i ] = results [ i ].seek_ms;
+    }
+    printf ( "%s: %u of %u referenced (%.2f %%)\n", name, referenced, count, 100.0 * referenced / count );
+    printSpread ( "seek ms", values, count );
+    free ( values );
+}
+
+/**
+ * Prints how many rigs landed and the spread of their landing times
+ * @param results   All rig results
+ * @param count     Number of rigs
+ */
+static void
+printLanding ( const rigResult_t *results, uint32_t count )
+{
+    double *values = malloc ( count * sizeof ( double ));
+    uint32_t landed = 0;
+    uint32_t i;
+
+    for ( i = 0; i < count; i++ )
+    {
+        landed += results [ i ].landed;
+        values [ i ] = results [ i ].land_ms;
+    }
+    printf ( "land: %u of %u landed (%.2f %%)\n", landed, count, 100.0 * landed / count );
+    printSpread ( "land ms", values, count );
+    free ( values );
+}
+
+int
+main ( int argc, char **argv )
+{
+    runState_t run = { 10000, { 1, 1.0, 0.1, 0.15 }, NULL, NULL, 0 };
+    pthread_t threads [ MAX_THREADS ];
+    long threads_wanted = sysconf ( _SC_NPROCESSORS_ONLN );
+    long started;
+    long i;
+    int error;
+    int opt;
+
+    while (( opt = getopt ( argc, argv, "n:j:s:a:m:b:" )) != -1 )
+    {
+        switch ( opt )
+        {
+        case 'n':
+            run.rigs = strtoul ( optarg, NULL, 10 );
+            break;
+        case 'j':
+            threads_wanted = strtol ( optarg, NULL, 10 );
+            break;
+        case 's':
+            run.spread.seed = strtoull ( optarg, NULL, 10 );
+            break;
+        case 'a':
+            run.spread.alt_noise = strtod ( optarg, NULL );
+            break;
+        case 'm':
+            run.spread.motor_spread = strtod ( optarg, NULL );
+            break;
+        case 'b':
+            run.spread.max_sag = strtod ( optarg, NULL );
+            break;
+        default:
+            fprintf ( stderr, "usage: %s [-n rigs] [-j threads] [-s seed] [-a noise] [-m spread] [-b sag]\n",
+                      argv [ 0 ] );
+            return 2;
+        }
+    }
+
+    if ( run.rigs == 0 || !( run.results = calloc ( run.rigs, sizeof ( rigResult_t )))
+            || !( run.stepped = calloc ( run.rigs, sizeof ( rigResult_t ))))
+    {
+        fprintf ( stderr, "no rigs to fly\n" );
+        return 2;
+    }
+
+    if ( threads_wanted < 1 )
+    {
+        threads_wanted = 1;
+    }
+
+    if ( threads_wanted > MAX_THREADS )
+    {
+        threads_wanted = MAX_THREADS;
+    }
+
+    for ( started = 0; started < threads_wanted; started++ )
+    {
+        if (( error = pthread_create ( &threads [ started ], NULL, worker, &run )) != 0 )
+        {
+            fprintf ( stderr, "thread %ld not started: %s\n", started, strerror ( error ));
+            break;
+        }
+    }
+
+    // The threads that did start share the work, with none this one does it
+    if ( started == 0 )
+    {
+        worker ( &run );
+    }
+
+    for ( i = 0; i < started; i++ )
+    {
+        pthread_join ( threads [ i ], NULL );
+    }
+
+    printf ( "%u rigs on %ld threads, seed %llu, noise %.2f %%, motor spread +-%.0f %%, sag up to %.0f %%\n",
+             run.rigs, started ? started : 1, ( unsigned long long ) run.spread.seed, run.spread.alt_noise, run.spread.motor_spread * 100,
+             run.spread.max_sag * 100 );
+    printSeek ( "seek", run.results, run.rigs );
+    printSeek ( "stepped seek", run.stepped, run.rigs );
+    printLanding ( run.results, run.rigs );
+    printLoop ( "alt", run.results, run.rigs, false );
+    printLoop ( "yaw", run.results, run.rigs, true );
+    free ( run.stepped );
+    free ( run.results );
+    return 0;
+}
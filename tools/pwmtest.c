@@ -0,0 +1,286 @@
+/* @file    pwmtest.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Host check of the rotor PWM setters. Runs PWM_main.c and
+ *          PWM_tail.c against stubbed TivaWare calls, checks the pulse
+ *          widths they write, and times the old percent path against the
+ *          cached-period Q16 path
+ *
+ * Build:   gcc -O2 -Itools/stub -I. -o pwmtest tools/pwmtest.c PWM_main.c PWM_tail.c format.c
+ * Usage:   pwmtest
+ *
+ * The old path is the setter as it was before the period was cached: it
+ * read the system clock and divided on every write. The SysCtlClockGet stub
+ * keeps only the register read and the divide by the SYSDIV field that the
+ * TivaWare version does, not its oscillator and PLL decode, so the timings
+ * understate the saving. The stubs are kept out of line, as driverlib calls
+ * are on the target. Exits 1 if any check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+#include "inc/hw_memmap.h"
+#include "driverlib/pwm.h"
+#include "driverlib/gpio.h"
+#include "driverlib/sysctl.h"
+#include "../PWM_main.h"
+#include "../PWM_tail.h"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define PLL_HZ                  200000000       // 400 MHz PLL, halved before the divider
+#define SYSDIV                  9               // RCC SYSDIV field of SYSCTL_SYSDIV_10
+#define CLOCK_HZ                ( PLL_HZ / ( SYSDIV + 1 ))
+#define PWM_RATE_HZ             250             // PWM_START_RATE_HZ of both rotors
+#define PERIOD                  ( CLOCK_HZ / PWM_RATE_HZ )
+#define BENCH_CALLS             5000000
+#define BENCH_ROUNDS            7               // Best of, the rounds interleave the paths
+
+/**********************************************************
+ * Global variables
+ **********************************************************/
+
+static uint32_t g_checks = 0;
+static uint32_t g_failures = 0;
+
+// What the stubs saw
+static volatile uint32_t g_sysdiv = SYSDIV;     // Stands in for the RCC register
+static volatile uint32_t g_width [ 2 ];         // Last pulse width, main then tail
+static uint32_t g_period [ 2 ];                 // Generator period set at init
+static uint32_t g_syncs = 0;
+
+/**********************************************************
+ * Stubs for the TivaWare calls
+ **********************************************************/
+
+/**
+ * Returns which rotor a PWM module drives
+ * @param base  PWM module base address
+ * @return      0 for the main rotor, 1 for the tail
+ */
+static uint32_t
+rotor ( uint32_t base )
+{
+    return base == PWM1_BASE;
+}
+
+void __attribute__ (( noinline ))
+PWMPulseWidthSet ( uint32_t base, uint32_t out, uint32_t width )
+{
+    ( void ) out;
+    g_width [ rotor ( base ) ] = width;
+}
+
+void
+PWMGenPeriodSet ( uint32_t base, uint32_t gen, uint32_t period )
+{
+    ( void ) gen;
+    g_period [ rotor ( base ) ] = period;
+}
+
+uint32_t
+PWMGenPeriodGet ( uint32_t base, uint32_t gen )
+{
+    ( void ) gen;
+    return g_period [ rotor ( base ) ];
+}
+
+void __attribute__ (( noinline ))
+PWMSyncUpdate ( uint32_t base, uint32_t gen_bits )
+{
+    ( void ) base;
+    ( void ) gen_bits;
+    ++g_syncs;
+}
+
+uint32_t __attribute__ (( noinline ))
+SysCtlClockGet ( void )
+{
+    return PLL_HZ / ( g_sysdiv + 1 );
+}
+
+void PWMGenConfigure ( uint32_t base, uint32_t gen, uint32_t config ) { ( void ) base; ( void ) gen; ( void ) config; }
+void PWMGenEnable ( uint32_t base, uint32_t gen ) { ( void ) base; ( void ) gen; }
+void PWMOutputState ( uint32_t base, uint32_t out_bits, bool enable ) { ( void ) base; ( void ) out_bits; ( void ) enable; }
+void GPIOPinConfigure ( uint32_t pin_config ) { ( void ) pin_config; }
+void GPIOPinTypePWM ( uint32_t port, uint8_t pins ) { ( void ) port; ( void ) pins; }
+void SysCtlPeripheralEnable ( uint32_t peripheral ) { ( void ) peripheral; }
+void displayString ( const char *text, uint32_t col, uint32_t row ) { ( void ) text; ( void ) col; ( void ) row; }
+
+/**
+ * Sets the main rotor duty the way setPWMmain did before the period was
+ * cached. Kept out of line like the firmware setter it replaces
+ * @param pwm   PWM value, percent
+ */
+static void __attribute__ (( noinline ))
+setPWMmainPercentOld ( int pwm )
+{
+    uint32_t period = SysCtlClockGet () / 1 / PWM_RATE_HZ;
+
+    PWMPulseWidthSet ( PWM0_BASE, PWM_OUT_7, period * pwm / 100 );
+}
+
+/**
+ * Counts one check and reports it if it failed
+ * @param passed    Result of the check
+ * @param name      What was checked
+ * @param value     Value printed on failure
+ */
+static void
+check ( bool passed, const char *name, long value )
+{
+    ++g_checks;
+
+    if ( !passed )
+    {
+        ++g_failures;
+        printf ( "FAIL %s (%ld)\n", name, value );
+    }
+}
+
+/**
+ * Checks the periods, and the pulse widths of every setter against the old
+ * percent path
+ */
+static void
+checkSetters ( void )
+{
+    uint32_t levels = 0;
+    uint32_t last = UINT32_MAX;
+    uint32_t worst = 0;
+    uint32_t error;
+    uint32_t width;
+    uint32_t old;
+    uint32_t duty;
+    int pwm;
+
+    check ( getPWMmainPeriod () == PERIOD && g_period [ 0 ] == PERIOD, "main period", getPWMmainPeriod ());
+    check ( getPWMtailPeriod () == PERIOD && g_period [ 1 ] == PERIOD, "tail period", getPWMtailPeriod ());
+
+    // The percent setters write what the old path wrote, and sync each write
+    for ( pwm = 0; pwm <= 100; pwm++ )
+    {
+        uint32_t syncs = g_syncs;
+
+        setPWMmainPercentOld ( pwm );
+        old = g_width [ 0 ];
+        setPWMmain ( pwm );
+        width = g_width [ 0 ];
+        check ( width == old && g_syncs == syncs + 1, "setPWMmain", pwm );
+        setPWMtail ( pwm );
+        width = g_width [ 1 ];
+        check ( width == old, "setPWMtail", pwm );
+
+        // The Q16 duty of each whole percent lands within a tick of it
+        setPWMmainQ16 (( uint32_t ) ( pwm * PWM_Q16_PER_PERCENT + 0.5f ));
+        width = g_width [ 0 ];
+        check ( width + 1 >= old && width <= old + 1, "setPWMmainQ16 at a whole percent", pwm );
+    }
+
+    // Out of range commands are clamped to the period
+    setPWMmain ( -5 );
+    width = g_width [ 0 ];
+    check ( width == 0, "negative percent", width );
+    setPWMmain ( 150 );
+    width = g_width [ 0 ];
+    check ( width == PERIOD, "percent past 100", width );
+    setPWMtailQ16 ( PWM_Q16_ONE );
+    width = g_width [ 1 ];
+    check ( width == PERIOD, "tail Q16 at 100 %", width );
+    setPWMtailQ16 ( UINT32_MAX );
+    width = g_width [ 1 ];
+    check ( width == PERIOD, "tail Q16 past 100 %", width );
+    setPWMmainTicks ( PERIOD + 1 );
+    width = g_width [ 0 ];
+    check ( width == PERIOD, "ticks past the period", width );
+
+    // Every Q16 step is a distinct, monotonic pulse width, as the period is
+    // longer than PWM_Q16_ONE
+    for ( duty = 0; duty <= PWM_Q16_ONE; duty++ )
+    {
+        uint32_t exact = ( uint32_t ) (( uint64_t ) PERIOD * duty / PWM_Q16_ONE );
+
+        setPWMmainQ16 ( duty );
+        width = g_width [ 0 ];
+        levels += ( width != last );
+        error = ( width > exact ) ? width - exact : exact - width;
+        worst = ( error > worst ) ? error : worst;
+        check ( last == UINT32_MAX || width > last, "Q16 monotonic", duty );
+        last = width;
+    }
+    check ( worst == 0, "Q16 rounding", worst );
+    printf ( "Pulse width levels from 0 to 100 %%: percent path 101, Q16 path %u of %u ticks\n", levels, PERIOD );
+}
+
+/**
+ * Returns a monotonic time
+ * @return  Nanoseconds
+ */
+static double
+now ( void )
+{
+    struct timespec time;
+
+    clock_gettime ( CLOCK_MONOTONIC, &time );
+    return time.tv_sec * 1e9 + time.tv_nsec;
+}
+
+// Times BENCH_CALLS runs of a statement, keeping the lowest ns/op in the
+// named variable
+#define BENCH( result, statement )                                      \
+    do                                                                  \
+    {                                                                   \
+        double start = now ();                                          \
+        double time;                                                    \
+        for ( i = 0; i < BENCH_CALLS; i++ )                             \
+        {                                                               \
+            statement;                                                  \
+        }                                                               \
+        time = ( now () - start ) / BENCH_CALLS;                        \
+        result = ( time < result ) ? time : result;                     \
+    } while ( 0 )
+
+/**
+ * Prints ns/op of one main rotor write from a float control signal, as the
+ * control task makes it on each path
+ */
+static void
+benchmark ( void )
+{
+    volatile float control = 37.25f;
+    double old = INFINITY;
+    double percent = INFINITY;
+    double q16 = INFINITY;
+    uint32_t round;
+    uint32_t i;
+
+    for ( round = 0; round < BENCH_ROUNDS; round++ )
+    {
+        BENCH ( old, setPWMmainPercentOld (( int ) ( control + ( i & 7 ))));
+        BENCH ( percent, setPWMmain (( int ) ( control + ( i & 7 ))));
+        BENCH ( q16, setPWMmainQ16 (( control + ( i & 7 )) * PWM_Q16_PER_PERCENT ));
+    }
+
+    printf ( "%-44s %6.2f ns\n", "old percent path, clock read and divide", old );
+    printf ( "%-44s %6.2f ns\n", "setPWMmain, cached period, with sync", percent );
+    printf ( "%-44s %6.2f ns\n", "setPWMmainQ16, cached period", q16 );
+}
+
+int
+main ( void )
+{
+    initPWMmain ();
+    initPWMtail ();
+
+    checkSetters ();
+    printf ( "%u checks, %u failed\n\n", g_checks, g_failures );
+
+    benchmark ();
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,403 @@
+/* @file    recordertest.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Linux check of the flight data recorder. Builds recorder.c
+ *          with RECORDER_RAM_FLASH and a small region, then flies it
+ *          through take-offs, landings, wraps, torn records and resets
+ *
+ * Build:   gcc -O2 -Itools/stub -I. -o recordertest tools/recordertest.c
+ * Usage:   recordertest [dump.bin]
+ *
+ * recorder.c is included directly so the test can tear a record in the
+ * RAM flash and watch the erase pointer. Every download is parsed and its
+ * sequence numbers checked. The last download is written to dump.bin when
+ * given, for tools/fdrdump.c. Exits 1 if any check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define RECORDER_RAM_FLASH
+#define RECORDER_SIZE           0x2000          // 8 pages of 32 records
+#include "../recorder.c"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define DUMP_SIZE               ( sizeof ( recorderHeader_t ) + RECORDER_SIZE )
+#define AHEAD_RECORDS           ( RECORDER_ERASE_AHEAD * RECORDS_PER_PAGE )
+#define PARK_TICKS              ( 2 * RECORDER_PAGES )  // Landed long enough to erase ahead
+
+/**********************************************************
+ * Global variables
+ **********************************************************/
+
+static uint32_t g_checks = 0;
+static uint32_t g_failures = 0;
+static heli_t g_heli;
+static uint32_t g_flight_erases = 0;            // Erases seen with the rotors on
+
+// Last download, as sent over the UART
+static uint8_t g_dump [ DUMP_SIZE ];
+static uint32_t g_dump_length = 0;
+static recorderHeader_t g_header;
+static flightRecord_t g_records [ RECORDER_RECORDS ];
+
+/**********************************************************
+ * Stubs for the drivers the recorder reads
+ **********************************************************/
+
+uint32_t
+getADCraw ( void )
+{
+    return 2048;
+}
+
+uint32_t
+getActuatorOutput ( uint8_t channel )
+{
+    return ( channel == ACTUATOR_MAIN ) ? PWM_Q16_ONE / 2 : PWM_Q16_ONE / 4;
+}
+
+void
+sendUARTbytes ( const uint8_t *data, uint32_t length )
+{
+    if ( g_dump_length + length <= DUMP_SIZE )
+    {
+        memcpy ( g_dump + g_dump_length, data, length );
+    }
+    g_dump_length += length;
+}
+
+void
+registerMemory ( const char *name, uint32_t bytes )
+{
+    ( void ) name;
+    ( void ) bytes;
+}
+
+int32_t
+FlashErase ( uint32_t address )
+{
+    ( void ) address;
+    return -1;
+}
+
+int32_t
+FlashProgram ( uint32_t *data, uint32_t address, uint32_t count )
+{
+    ( void ) data;
+    ( void ) address;
+    ( void ) count;
+    return -1;
+}
+
+/**
+ * Counts one check and reports it if it failed
+ * @param passed    Result of the check
+ * @param name      What was checked
+ * @param value     The value checked, printed on failure
+ */
+static void
+check ( bool passed, const char *name, long value )
+{
+    ++g_checks;
+
+    if ( !passed )
+    {
+        ++g_failures;
+        fprintf ( stderr, "FAIL %s (%ld)\n", name, value );
+    }
+}
+
+/**
+ * Blanks the RAM flash as a new part arrives and powers up the recorder
+ */
+static void
+powerUpBlank ( void )
+{
+    memset ( g_ram_flash, 0xFF, sizeof ( g_ram_flash ));
+    memset ( &g_heli, 0, sizeof ( g_heli ));
+    initRecorder ();
+}
+
+/**
+ * Runs control ticks as main.c does, recording then servicing the flash
+ * @param state     Flight state for every tick
+ * @param pwm_on    Rotor outputs for every tick
+ * @param ticks     Number of ticks
+ */
+static void
+runTicks ( uint8_t state, bool pwm_on, uint32_t ticks )
+{
+    g_heli.fsm.state = state;
+    g_heli.actuators.pwm_on = pwm_on;
+
+    while ( ticks-- )
+    {
+        uint32_t erase_page = g_erase_page;
+
+        g_heli.sensors.altitude = ticks % 100;
+        recordFlight ( &g_heli, 0 );
+        serviceRecorder ( &g_heli );
+
+        g_flight_erases += pwm_on && g_erase_page != erase_page;
+    }
+}
+
+/**
+ * Flies one flight: take-off, a number of ticks off the ground, then the
+ * landing with the rotors spinning down, and parks on the ground
+ * @param ticks     Ticks off the ground
+ */
+static void
+fly ( uint32_t ticks )
+{
+    runTicks ( STATE_LANDED, false, PARK_TICKS );
+    runTicks ( STATE_FLYING, true, ticks );
+    runTicks ( STATE_LANDED, true, 4 );
+    runTicks ( STATE_LANDED, false, PARK_TICKS );
+}
+
+/**
+ * Downloads the recorder and parses what was sent
+ * @return  Number of records downloaded
+ */
+static uint32_t
+download ( void )
+{
+    g_dump_length = 0;
+    check ( dumpRecorder ( &g_heli ), "download refused while landed", g_heli.fsm.state );
+    memcpy ( &g_header, g_dump, sizeof ( g_header ));
+    check ( g_header.magic == RECORDER_MAGIC, "download magic", g_header.magic );
+    check ( g_dump_length == sizeof ( g_header ) + g_header.count * sizeof ( flightRecord_t ), "download length",
+            g_dump_length );
+    memcpy ( g_records, g_dump + sizeof ( g_header ), g_header.count * sizeof ( flightRecord_t ));
+    return g_header.count;
+}
+
+/**
+ * Checks that downloaded records run oldest first with no gaps
+ * @param first     Index of the first record to check
+ * @param count     Number of records to check
+ * @param seq       Sequence number expected of the first
+ * @param name      What was checked
+ */
+static void
+checkSequence ( uint32_t first, uint32_t count, uint32_t seq, const char *name )
+{
+    uint32_t i;
+
+    for ( i = 0; i < count && g_records [ first + i ].seq == seq + i; i++ )
+    {
+    }
+    check ( i == count, name, i );
+}
+
+/**
+ * Records a short flight on blank flash and downloads it
+ */
+static void
+testFirstFlight ( void )
+{
+    uint32_t count;
+
+    powerUpBlank ();
+    count = download ();
+    check ( count == 0, "blank download", count );
+
+    g_heli.fsm.state = STATE_FLYING;
+    check ( !dumpRecorder ( &g_heli ), "download allowed in flight", 0 );
+
+    fly ( 80 );
+    count = download ();
+    check ( count == 80, "first flight records", count );
+    checkSequence ( 0, 80, 0, "first flight sequence" );
+    check ( g_header.dropped == 0, "first flight dropped", g_header.dropped );
+    check ( g_records [ 0 ].main_duty == 5000 && g_records [ 0 ].tail_duty == 2500, "recorded duty",
+            g_records [ 0 ].main_duty );
+}
+
+/**
+ * Flies several times longer than the region. Once the pages erased ahead
+ * are used, the oldest page is erased in flight, so nothing is dropped and
+ * the download ends with the newest records of the flight
+ */
+static void
+testLongFlight ( void )
+{
+    uint32_t flight = 3 * RECORDER_RECORDS;
+    uint32_t count;
+    uint32_t seq;
+
+    powerUpBlank ();
+    g_flight_erases = 0;
+    fly ( flight );
+
+    check ( g_flight_erases >= ( flight - AHEAD_RECORDS ) / RECORDS_PER_PAGE, "pages erased in flight",
+            g_flight_erases );
+    count = download ();
+    check ( count >= RECORDER_RECORDS - AHEAD_RECORDS - RECORDS_PER_PAGE, "long flight records", count );
+    checkSequence ( 0, count, flight - count, "long flight sequence" );
+    seq = g_records [ count - 1 ].seq;
+    check ( seq == flight - 1, "long flight ends with its last tick", seq );
+    check ( g_header.dropped == 0, "long flight dropped", g_header.dropped );
+}
+
+/**
+ * Flies enough flights to wrap the ring several times. After each landing
+ * and the erase ahead, the whole of the last flight must still download,
+ * newest last
+ */
+static void
+testWrap ( void )
+{
+    uint32_t seq = 0;
+    uint32_t flight;
+
+    powerUpBlank ();
+    g_flight_erases = 0;
+
+    for ( flight = 0; flight < 20; flight++ )
+    {
+        uint32_t ticks = 40 + flight * 37 % AHEAD_RECORDS;
+        uint32_t count;
+
+        if ( ticks > AHEAD_RECORDS )
+        {
+            ticks = AHEAD_RECORDS;
+        }
+        fly ( ticks );
+        count = download ();
+
+        check ( count >= ticks, "last flight kept after the erase ahead", count );
+        check ( count <= RECORDER_RECORDS, "records beyond the region", count );
+        checkSequence ( count >= ticks ? count - ticks : 0, ticks, seq, "last flight sequence" );
+
+        // Whatever older records remain still run oldest first
+        check ( count == 0 || g_records [ count - 1 ].seq == seq + ticks - 1, "newest record last",
+                g_records [ count - 1 ].seq );
+        seq += ticks;
+    }
+    check ( g_flight_erases == 0, "pages erased with the rotors on while wrapping", g_flight_erases );
+}
+
+/**
+ * Cuts the power in the middle of programming a record, then powers up
+ * again. The torn record must be skipped, and recording must carry on from
+ * the newest whole record on a fresh page
+ */
+static void
+testTornRecord ( void )
+{
+    flightRecord_t record;
+    uint32_t *slot;
+    uint32_t count;
+    uint32_t i;
+
+    powerUpBlank ();
+    fly ( 50 );
+
+    // Half of the next record reaches the flash before the power goes
+    g_heli.fsm.state = STATE_FLYING;
+    recordFlight ( &g_heli, 0 );
+    record = g_queue [ g_queue_rindex & ( RECORDER_QUEUE_SIZE - 1 ) ];
+    slot = ( uint32_t * ) recordAt ( g_write_index );
+
+    for ( i = 0; i < sizeof ( record ) / sizeof ( uint32_t ) / 2; i++ )
+    {
+        slot [ i ] &= (( uint32_t * ) &record ) [ i ];
+    }
+
+    memset ( &g_heli, 0, sizeof ( g_heli ));
+    initRecorder ();
+    check ( g_next_seq == 50, "sequence after a torn record", g_next_seq );
+    check ( g_write_index % RECORDS_PER_PAGE == 0, "fresh page after a torn record", g_write_index );
+
+    fly ( 30 );
+    count = download ();
+    check ( count == 80, "records around a torn record", count );
+    checkSequence ( 0, 80, 0, "sequence around a torn record" );
+}
+
+/**
+ * Misses control ticks in flight. The sequence numbers must skip them, so
+ * the download still times each record from its tick
+ */
+static void
+testMissedTicks ( void )
+{
+    uint32_t count;
+    uint32_t seq;
+
+    powerUpBlank ();
+    runTicks ( STATE_LANDED, false, PARK_TICKS );
+    runTicks ( STATE_FLYING, true, 10 );
+    recordFlight ( &g_heli, 3 );
+    serviceRecorder ( &g_heli );
+    runTicks ( STATE_FLYING, true, 9 );
+    runTicks ( STATE_LANDED, false, PARK_TICKS );
+
+    count = download ();
+    check ( count == 20, "records around missed ticks", count );
+    checkSequence ( 0, 10, 0, "sequence before missed ticks" );
+    checkSequence ( 10, 10, 13, "sequence after missed ticks" );
+    seq = g_records [ count - 1 ].seq;
+    check ( seq == 22, "ticks counted across missed ticks", seq );
+}
+
+/**
+ * Powers up again between flights. Each power-up continues the ring and
+ * the sequence numbers where the last one stopped
+ */
+static void
+testResume ( void )
+{
+    uint32_t reset;
+    uint32_t count;
+
+    powerUpBlank ();
+
+    for ( reset = 0; reset < 3; reset++ )
+    {
+        fly ( 20 );
+        memset ( &g_heli, 0, sizeof ( g_heli ));
+        initRecorder ();
+        check ( g_next_seq == ( reset + 1 ) * 20, "sequence after a reset", g_next_seq );
+    }
+    fly ( 20 );
+    count = download ();
+    check ( count == 80, "records across resets", count );
+    checkSequence ( 0, 80, 0, "sequence across resets" );
+    check ( g_header.dropped == 0, "dropped across resets", g_header.dropped );
+}
+
+int
+main ( int argc, char **argv )
+{
+    FILE *file;
+
+    testFirstFlight ();
+    testLongFlight ();
+    testTornRecord ();
+    testMissedTicks ();
+    testWrap ();
+    testResume ();
+
+    if ( argc > 1 )
+    {
+        if ( !( file = fopen ( argv [ 1 ], "wb" )) || fwrite ( g_dump, 1, g_dump_length, file ) != g_dump_length )
+        {
+            fprintf ( stderr, "cannot write %s\n", argv [ 1 ] );
+            return 2;
+        }
+        fclose ( file );
+    }
+
+    printf ( "%u checks, %u failed\n", g_checks, g_failures );
+    return g_failures ? 1 : 0;
+}
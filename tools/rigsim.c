@@ -0,0 +1,384 @@
+/* @file    rigsim.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Simulated rig for the host tools. A simple plant with motor
+ *          variation, battery sag and altitude sensor noise, flown by the
+ *          firmware flight state machine, control laws and command shaping
+ *          and scored by the firmware step metrics
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../PWM_main.h"
+#include "../control.h"
+#include "../flight.h"
+#include "../shape.h"
+#include "rigsim.h"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define HOVER_TICKS             ( HOVER_SECONDS * CONTROL_RATE_HZ )
+#define SIM_TICKS               ( SIM_SECONDS * CONTROL_RATE_HZ )
+#define SEEK_TICKS              ( SEEK_SECONDS * CONTROL_RATE_HZ )
+#define LAND_TICKS              ( LAND_SECONDS * CONTROL_RATE_HZ )
+#define STATE_TICKS             ( CONTROL_RATE_HZ / STATE_UPDATE_HZ )   // Control updates per state update
+#define TICK_US                 ( 1000000 / CONTROL_RATE_HZ )           // Control update period
+#define ALT_SETTLE_BAND         2       // As PID.c
+#define YAW_SETTLE_BAND         2       // As PID.c
+#define STEPPED_SEEK_STEP       15      // Target step of the old search, as buttons.c before the sweep
+#define STEPPED_SEEK_BAND       2       // Yaw error that counted as settled on the old target
+
+// Nominal plant. The rig stand is heavily damped, so altitude settles
+// towards the height where the thrust balances it rather than accelerating
+#define HOVER_THRUST            0.35    // Main thrust fraction that just lifts off
+#define MOTOR_LAG_S             0.3     // Rotor speed time constant
+#define ALT_GAIN                300.0   // Settled altitude per unit thrust above lift-off, percent
+#define ALT_LAG_S               1.0     // Altitude time constant of the stand
+#define ALT_CEILING             110.0   // Rig travel limit, percent
+#define YAW_GAIN                800.0   // Yaw acceleration per unit net torque, degrees/s^2
+#define YAW_DRAG                10.0    // Yaw rate damping of the stand bearing, 1/s
+#define TAIL_TORQUE             ( 1 / 0.85 )    // Tail torque per duty, main reaction torque is 1
+
+/**********************************************************
+ * Type definitions
+ **********************************************************/
+
+// State of one simulated rig
+typedef struct {
+    double main_thrust;                 // Main rotor thrust, fraction of full
+    double tail_thrust;                 // Tail rotor thrust, fraction of full
+    double alt;                         // Altitude, percent
+    double yaw;                         // Yaw, degrees
+    double yaw_rate;                    // Yaw rate, degrees per second
+} plant_t;
+
+// One simulated rig in flight
+typedef struct {
+    heli_t heli;                        // Controller context, as the firmware keeps it
+    plant_t plant;
+    const rigParams_t *params;
+    uint64_t *random;                   // Generator state for the sensor noise
+    const actuatorShape_t *shape [ NUM_ACTUATORS ];     // Command shaping per channel, as actuator.c
+    uint32_t output [ NUM_ACTUATORS ];  // Last shaped duty per channel, Q16
+    double yaw_zero;                    // Plant yaw the decoder counts from
+    bool referenced;                    // Set once the reference edge has been seen
+    uint8_t mode_switch;                // Switch change for the next state update, enum butStates
+    uint8_t actions;                    // Flags returned by the state updates so far
+    uint32_t tick;                      // Control updates run
+} rig_t;
+
+/**
+ * Returns the next value of a splitmix64 generator
+ * @param state Generator state
+ * @return      64 random bits
+ */
+uint64_t
+nextRandom ( uint64_t *state )
+{
+    uint64_t z = ( *state += 0x9E3779B97F4A7C15ULL );
+
+    z = ( z ^ ( z >> 30 )) * 0xBF58476D1CE4E5B9ULL;
+    z = ( z ^ ( z >> 27 )) * 0x94D049BB133111EBULL;
+    return z ^ ( z >> 31 );
+}
+
+/**
+ * Returns a uniform value in [0, 1)
+ * @param state Generator state
+ * @return      The value
+ */
+double
+uniform ( uint64_t *state )
+{
+    return ( nextRandom ( state ) >> 11 ) * ( 1.0 / 9007199254740992.0 );
+}
+
+/**
+ * Returns a standard normal value
+ * @param state Generator state
+ * @return      The value
+ */
+static double
+gaussian ( uint64_t *state )
+{
+    double u = uniform ( state );
+
+    return sqrt ( -2.0 * log ( 1.0 - u )) * cos ( 2.0 * M_PI * uniform ( state ));
+}
+
+/**
+ * Draws the variation of one rig. The generator is seeded by the run seed
+ * and the rig number alone, so a rig is the same whichever thread flies it
+ * @param spread    Spread of the variation
+ * @param rig       Rig number
+ * @param params    Destination for the variation
+ * @param random    Destination for the generator state, for the sensor noise
+ */
+void
+drawRig ( const rigSpread_t *spread, uint32_t rig, rigParams_t *params, uint64_t *random )
+{
+    *random = spread->seed ^ (( uint64_t ) rig * 0xD1B54A32D192ED03ULL );
+    params->main_gain = 1.0 + spread->motor_spread * ( 2 * uniform ( random ) - 1 );
+    params->tail_gain = 1.0 + spread->motor_spread * ( 2 * uniform ( random ) - 1 );
+    params->sag = spread->max_sag * uniform ( random );
+    params->ref_angle = 360.0 * uniform ( random );
+    params->alt_noise = spread->alt_noise;
+    params->seek = SEEK_SWEEP;
+}
+
+/**
+ * Advances the plant of one rig by one control period
+ * @param plant     The plant
+ * @param params    The rig variation
+ * @param output    Shaped main and tail duty, Q16
+ * @param pwm_on    False while the rotor outputs are disabled
+ * @param supply    Supply voltage relative to nominal
+ */
+static void
+stepPlant ( plant_t *plant, const rigParams_t *params, const uint32_t *output, bool pwm_on, double supply )
+{
+    double dt = 1.0 / CONTROL_RATE_HZ;
+    double main_duty = pwm_on ? output [ ACTUATOR_MAIN ] / ( double ) PWM_Q16_ONE : 0;
+    double tail_duty = pwm_on ? output [ ACTUATOR_TAIL ] / ( double ) PWM_Q16_ONE : 0;
+
+    plant->main_thrust += ( params->main_gain * supply * main_duty - plant->main_thrust ) * dt / MOTOR_LAG_S;
+    plant->tail_thrust += ( params->tail_gain * supply * tail_duty - plant->tail_thrust ) * dt / MOTOR_LAG_S;
+
+    // Altitude rests on the ground and stops at the top of the rig
+    plant->alt += ( ALT_GAIN * ( plant->main_thrust - HOVER_THRUST ) - plant->alt ) * dt / ALT_LAG_S;
+
+    if ( plant->alt < 0 )
+    {
+        plant->alt = 0;
+    }
+
+    if ( plant->alt > ALT_CEILING )
+    {
+        plant->alt = ALT_CEILING;
+    }
+
+    plant->yaw_rate += ( YAW_GAIN * ( TAIL_TORQUE * plant->tail_thrust - plant->main_thrust )
+                         - YAW_DRAG * plant->yaw_rate ) * dt;
+    plant->yaw += plant->yaw_rate * dt;
+}
+
+/**
+ * Runs one control update of a rig, shaping the commands as
+ * applyActuatorCommand does, with a flight state update every STATE_TICKS
+ * as the firmware button task does, then advances its plant
+ * @param rig       The rig
+ * @param supply    Supply voltage relative to nominal
+ */
+static void
+tickRig ( rig_t *rig, double supply )
+{
+    heli_t *heli = &rig->heli;
+    plant_t *plant = &rig->plant;
+
+    heli->sensors.altitude = ( int32_t ) lround ( plant->alt + rig->params->alt_noise * gaussian ( rig->random ));
+    heli->sensors.yaw = ( int32_t ) lround ( plant->yaw - rig->yaw_zero );
+    mainControl ( heli );
+    tailControl ( heli );
+    rig->output [ ACTUATOR_MAIN ] = shapeCommand ( rig->shape [ ACTUATOR_MAIN ], rig->output [ ACTUATOR_MAIN ],
+                                                   heli->actuators.main_command );
+    rig->output [ ACTUATOR_TAIL ] = shapeCommand ( rig->shape [ ACTUATOR_TAIL ], rig->output [ ACTUATOR_TAIL ],
+                                                   heli->actuators.tail_command );
+
+    if ( rig->tick % STATE_TICKS == 0 )
+    {
+        flightInputs_t inputs;
+        uint8_t i;
+
+        for ( i = 0; i < NUM_BUTS; i++ )
+        {
+            inputs.buttons [ i ] = NO_CHANGE;
+        }
+        inputs.buttons [ SWITCH ] = rig->mode_switch;
+        inputs.yaw_referenced = rig->referenced;
+        rig->mode_switch = NO_CHANGE;
+
+        int32_t seek_target = heli->setpoints.yaw;
+
+        updateFlightTargets ( heli, &inputs );
+        updateOutputEnable ( heli );
+        rig->actions |= updateFlightState ( heli, &inputs );
+
+        // The old search held the target until the rig settled on it, then
+        // stepped it on
+        if ( rig->params->seek == SEEK_STEPPED && heli->fsm.state == STATE_CALIBRATION )
+        {
+            heli->setpoints.yaw = seek_target;
+
+            if ( abs ( heli->sensors.yaw - seek_target ) < STEPPED_SEEK_BAND )
+            {
+                heli->setpoints.yaw -= STEPPED_SEEK_STEP;
+            }
+        }
+    }
+    stepPlant ( plant, rig->params, rig->output, heli->actuators.pwm_on, supply );
+
+    // The decoder counts from the reference once its edge is seen
+    if ( !rig->referenced && plant->yaw <= -rig->params->ref_angle )
+    {
+        rig->referenced = true;
+        rig->yaw_zero = plant->yaw;
+    }
+    ++rig->tick;
+}
+
+/**
+ * Puts a rig on the ground with the motors off and clears its result
+ * @param rig       The rig
+ * @param params    The rig variation
+ * @param main      Main rotor gains, NULL for the firmware defaults
+ * @param tail      Tail rotor gains, NULL for the firmware defaults
+ * @param random    Generator state for the sensor noise
+ * @param result    Destination for the metrics
+ */
+static void
+startRig ( rig_t *rig, const rigParams_t *params, const gains_t *main, const gains_t *tail, uint64_t *random,
+           rigResult_t *result )
+{
+    memset ( rig, 0, sizeof ( *rig ));
+    rig->params = params;
+    rig->random = random;
+    rig->shape [ ACTUATOR_MAIN ] = getDefaultShape ( ACTUATOR_MAIN );
+    rig->shape [ ACTUATOR_TAIL ] = getDefaultShape ( ACTUATOR_TAIL );
+    initControl ( &rig->heli );
+    initFlightState ( &rig->heli );
+
+    if ( main )
+    {
+        rig->heli.main_pid.gains = *main;
+    }
+
+    if ( tail )
+    {
+        rig->heli.tail_pid.gains = *tail;
+    }
+
+    // A step that never finishes is reported unsettled with the timeout
+    memset ( result, 0, sizeof ( *result ));
+    result->alt.settle_ms = result->yaw.settle_ms = SIM_SECONDS * 1000;
+}
+
+/**
+ * Takes off on the mode switch and runs the yaw reference seek
+ * @param rig       The rig, on the ground
+ * @param result    Destination for the seek time
+ * @return          True if the reference was found in time
+ */
+static bool
+seekReference ( rig_t *rig, rigResult_t *result )
+{
+    uint32_t tick;
+
+    // The mode switch starts down, then goes up to take off and seek
+    rig->mode_switch = RELEASED;
+
+    for ( tick = 0; tick < STATE_TICKS; tick++ )
+    {
+        tickRig ( rig, 1.0 );
+    }
+    rig->mode_switch = PUSHED;
+
+    for ( tick = 0; tick < SEEK_TICKS && !( rig->actions & FLIGHT_REFERENCED ); tick++ )
+    {
+        tickRig ( rig, 1.0 );
+    }
+    result->seek_ms = tick * 1000 / CONTROL_RATE_HZ;
+    result->referenced = ( rig->actions & FLIGHT_REFERENCED ) != 0;
+    return result->referenced;
+}
+
+/**
+ * Takes off one rig and seeks the yaw reference, then stops. Records the
+ * seek time only, for comparing the yaw reference searches
+ * @param params    The rig variation, including the search to use
+ * @param random    Generator state for the sensor noise
+ * @param result    Destination for the seek time
+ */
+void
+seekRig ( const rigParams_t *params, uint64_t *random, rigResult_t *result )
+{
+    rig_t rig;
+
+    startRig ( &rig, params, NULL, NULL, random, result );
+    seekReference ( &rig, result );
+}
+
+/**
+ * Flies one rig through the whole flight sequence: take-off on the mode
+ * switch, the yaw reference seek, a hover, the altitude and yaw step, and
+ * the landing. Records the seek and landing times and the step metrics of
+ * both loops. Touches nothing outside its arguments
+ * @param params    The rig variation
+ * @param main      Main rotor gains, NULL for the firmware defaults
+ * @param tail      Tail rotor gains, NULL for the firmware defaults
+ * @param random    Generator state for the sensor noise
+ * @param result    Destination for the metrics
+ */
+void
+flyRig ( const rigParams_t *params, const gains_t *main, const gains_t *tail, uint64_t *random,
+         rigResult_t *result )
+{
+    rig_t rig;
+    stepTracker_t alt_tracker;
+    stepTracker_t yaw_tracker;
+    bool alt_done = false;
+    bool yaw_done = false;
+    double supply = 1.0;
+    uint32_t tick;
+
+    startRig ( &rig, params, main, tail, random, result );
+
+    if ( !seekReference ( &rig, result ))
+    {
+        return;
+    }
+
+    setAltitudeTarget ( &rig.heli, ALT_START );
+
+    for ( tick = 0; tick < HOVER_TICKS; tick++ )
+    {
+        tickRig ( &rig, supply );
+    }
+
+    initStepTracker ( &alt_tracker, ALT_SETTLE_BAND, rig.heli.setpoints.altitude );
+    initStepTracker ( &yaw_tracker, YAW_SETTLE_BAND, rig.heli.setpoints.yaw );
+    setAltitudeTarget ( &rig.heli, ALT_TARGET );
+    setYawTarget ( &rig.heli, YAW_TARGET );
+
+    for ( tick = 0; tick < SIM_TICKS && !( alt_done && yaw_done ); tick++ )
+    {
+        supply = 1.0 - params->sag * tick / SIM_TICKS;
+        tickRig ( &rig, supply );
+
+        if ( !alt_done )
+        {
+            alt_done = updateStepTracker ( &alt_tracker, rig.heli.setpoints.altitude, rig.heli.sensors.altitude,
+                                           TICK_US, &result->alt );
+        }
+
+        if ( !yaw_done )
+        {
+            yaw_done = updateStepTracker ( &yaw_tracker, rig.heli.setpoints.yaw, rig.heli.sensors.yaw, TICK_US,
+                                           &result->yaw );
+        }
+    }
+
+    // The mode switch goes down to land
+    rig.mode_switch = RELEASED;
+
+    for ( tick = 0; tick < LAND_TICKS && !( rig.actions & FLIGHT_LANDED ); tick++ )
+    {
+        tickRig ( &rig, supply );
+    }
+    result->land_ms = tick * 1000 / CONTROL_RATE_HZ;
+    result->landed = ( rig.actions & FLIGHT_LANDED ) != 0;
+}
@@ -0,0 +1,119 @@
+/* @file    rigsim.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Header file for the simulated rig shared by the host tools
+ */
+
+#ifndef RIGSIM_H_
+#define RIGSIM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../heli.h"
+#include "../metrics.h"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define CONTROL_RATE_HZ         80      // Control update rate of the firmware
+#define HOVER_SECONDS           20      // Hover ahead of the step
+#define SIM_SECONDS             30      // Simulated time after the step, past the metrics timeout
+#define SEEK_SECONDS            60      // Longest yaw reference seek
+#define LAND_SECONDS            30      // Longest landing
+#define ALT_START               20      // Hover before the step, percent
+#define ALT_TARGET              50      // Altitude after the step, percent
+#define YAW_TARGET              90      // Yaw step, degrees
+
+// Yaw reference searches
+enum seekModes { SEEK_SWEEP = 0, SEEK_STEPPED };   // Firmware constant-rate sweep, or the 15 degree steps it replaced
+
+/**********************************************************
+ * Type definitions
+ **********************************************************/
+
+// Variation of one simulated rig
+typedef struct {
+    double main_gain;                   // Main motor thrust relative to nominal
+    double tail_gain;                   // Tail motor thrust relative to nominal
+    double sag;                         // Supply drop by the end of the run, fraction
+    double alt_noise;                   // Altitude sensor noise, percent RMS
+    double ref_angle;                   // Turn from power-up to the yaw reference, degrees
+    uint8_t seek;                       // Yaw reference search, enum seekModes
+} rigParams_t;
+
+// Spread of the rig variation
+typedef struct {
+    uint64_t seed;                      // Seed of the whole run
+    double alt_noise;                   // Altitude sensor noise, percent RMS
+    double motor_spread;                // Largest motor thrust error, fraction
+    double max_sag;                     // Largest supply drop, fraction
+} rigSpread_t;
+
+// Outcome of one rig
+typedef struct {
+    uint32_t seek_ms;                   // Take-off to the yaw reference
+    uint32_t land_ms;                   // Mode switch down to landed
+    bool referenced;                    // False if the seek timed out
+    bool landed;                        // False if the landing timed out
+    stepMetrics_t alt;
+    stepMetrics_t yaw;
+} rigResult_t;
+
+/**********************************************************
+ * Function declarations
+ **********************************************************/
+
+/**
+ * Returns the next value of a splitmix64 generator
+ * @param state Generator state
+ * @return      64 random bits
+ */
+uint64_t
+nextRandom ( uint64_t *state );
+
+/**
+ * Returns a uniform value in [0, 1)
+ * @param state Generator state
+ * @return      The value
+ */
+double
+uniform ( uint64_t *state );
+
+/**
+ * Draws the variation of one rig. The generator is seeded by the run seed
+ * and the rig number alone, so a rig is the same whichever thread flies it
+ * @param spread    Spread of the variation
+ * @param rig       Rig number
+ * @param params    Destination for the variation
+ * @param random    Destination for the generator state, for the sensor noise
+ */
+void
+drawRig ( const rigSpread_t *spread, uint32_t rig, rigParams_t *params, uint64_t *random );
+
+/**
+ * Flies one rig through the whole flight sequence: take-off on the mode
+ * switch, the yaw reference seek, a hover, the altitude and yaw step, and
+ * the landing. Records the seek and landing times and the step metrics of
+ * both loops. Touches nothing outside its arguments
+ * @param params    The rig variation
+ * @param main      Main rotor gains, NULL for the firmware defaults
+ * @param tail      Tail rotor gains, NULL for the firmware defaults
+ * @param random    Generator state for the sensor noise
+ * @param result    Destination for the metrics
+ */
+void
+flyRig ( const rigParams_t *params, const gains_t *main, const gains_t *tail, uint64_t *random,
+         rigResult_t *result );
+
+/**
+ * Takes off one rig and seeks the yaw reference, then stops. Records the
+ * seek time only, for comparing the yaw reference searches
+ * @param params    The rig variation, including the search to use
+ * @param random    Generator state for the sensor noise
+ * @param result    Destination for the seek time
+ */
+void
+seekRig ( const rigParams_t *params, uint64_t *random, rigResult_t *result );
+
+#endif /* RIGSIM_H_ */
@@ -0,0 +1,401 @@
+/* @file    shapetest.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Linux check of the rotor command shaping. Runs shape.c and
+ *          actuator.c against stubbed PWM and interrupt calls and checks
+ *          the rate limits, dead band and thrust table
+ *
+ * Build:   gcc -O2 -Itools/stub -I. -o shapetest tools/shapetest.c shape.c actuator.c -lm
+ * Usage:   shapetest
+ *
+ * Every shaped output is also compared against a floating point model of
+ * the same stages, to two Q16 steps, over random commands and tables.
+ * Exits 1 if any check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include "../PWM_main.h"
+#include "../PWM_tail.h"
+#include "../actuator.h"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define RANDOM_CASES            1000000
+#define MAIN_STEP               ( PWM_Q16_ONE / 100 )   // Default main rate limit
+#define TAIL_STEP               ( PWM_Q16_ONE / 50 )    // Default tail rate limit
+#define PERCENT_20              ( PWM_Q16_ONE / 5 )
+
+/**********************************************************
+ * Global variables
+ **********************************************************/
+
+static uint32_t g_checks = 0;
+static uint32_t g_failures = 0;
+
+// What the stubs saw
+static uint32_t g_staged [ NUM_ACTUATORS ];     // Last duty staged per channel
+static uint32_t g_syncs [ NUM_ACTUATORS ];      // Syncs per channel
+static uint32_t g_unmasked_syncs = 0;           // Syncs issued with interrupts enabled
+static uint32_t g_unstaged_syncs = 0;           // Syncs issued before both channels were staged
+static uint32_t g_staged_count = 0;             // Channels staged since the last pair of syncs
+static bool g_masked = false;
+
+/**********************************************************
+ * Stubs for the PWM driver and interrupt controller
+ **********************************************************/
+
+void
+setPWMmainQ16 ( uint32_t duty )
+{
+    g_staged [ ACTUATOR_MAIN ] = duty;
+    ++g_staged_count;
+}
+
+void
+setPWMtailQ16 ( uint32_t duty )
+{
+    g_staged [ ACTUATOR_TAIL ] = duty;
+    ++g_staged_count;
+}
+
+/**
+ * Counts a sync, noting any made with interrupts enabled or before both
+ * channels were staged
+ * @param channel   The synced channel
+ */
+static void
+countSync ( uint8_t channel )
+{
+    ++g_syncs [ channel ];
+    g_unmasked_syncs += !g_masked;
+    g_unstaged_syncs += ( g_staged_count < NUM_ACTUATORS );
+
+    if ( channel == ACTUATOR_TAIL )
+    {
+        g_staged_count = 0;
+    }
+}
+
+void
+syncPWMmain ( void )
+{
+    countSync ( ACTUATOR_MAIN );
+}
+
+void
+syncPWMtail ( void )
+{
+    countSync ( ACTUATOR_TAIL );
+}
+
+bool
+IntMasterDisable ( void )
+{
+    bool was_masked = g_masked;
+
+    g_masked = true;
+    return was_masked;
+}
+
+bool
+IntMasterEnable ( void )
+{
+    bool was_masked = g_masked;
+
+    g_masked = false;
+    return was_masked;
+}
+
+/**
+ * Counts one check and reports it if it failed
+ * @param passed    Result of the check
+ * @param name      What was checked
+ * @param value     The value checked, printed on failure
+ */
+static void
+check ( bool passed, const char *name, long value )
+{
+    ++g_checks;
+
+    if ( !passed )
+    {
+        ++g_failures;
+        fprintf ( stderr, "FAIL %s (%ld)\n", name, value );
+    }
+}
+
+/**
+ * Returns the next value of an xorshift generator
+ * @param state Generator state
+ * @return      32 random bits
+ */
+static uint32_t
+nextRandom ( uint32_t *state )
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+/**
+ * Floating point model of shapeCommand
+ * @param shape     The channel shaping
+ * @param last      Duty cycle of the previous update, Q16
+ * @param command   Requested thrust, Q16
+ * @return          Duty cycle the shaping should give, Q16
+ */
+static double
+modelCommand ( const actuatorShape_t *shape, uint32_t last, uint32_t command )
+{
+    double thrust = ( command > PWM_Q16_ONE ? PWM_Q16_ONE : command ) / ( double ) PWM_Q16_ONE;
+    double duty = 0;
+
+    if ( thrust > 0 )
+    {
+        double position = thrust * ( ACTUATOR_TABLE_POINTS - 1 );
+        int index = ( int ) position;
+        double low = shape->thrust_table [ index ];
+        double high = ( index < ACTUATOR_TABLE_POINTS - 1 ) ? shape->thrust_table [ index + 1 ] : low;
+
+        duty = low + ( high - low ) * ( position - index );
+        duty = shape->dead_band + duty * ( PWM_Q16_ONE - shape->dead_band ) / PWM_Q16_ONE;
+    }
+
+    if ( duty > ( double ) last + shape->rate_limit )
+    {
+        duty = ( double ) last + shape->rate_limit;
+    } else if ( duty < ( double ) last - shape->rate_limit )
+    {
+        duty = ( double ) last - shape->rate_limit;
+    }
+    return duty;
+}
+
+/**
+ * Fills a shaping with no rate limit, a dead band and a monotonic table
+ * bent by a square root, as a motor with thrust rising with speed squared
+ * @param shape     Destination for the shaping
+ * @param dead_band Dead band, Q16
+ */
+static void
+makeShape ( actuatorShape_t *shape, uint32_t dead_band )
+{
+    uint32_t i;
+
+    shape->rate_limit = PWM_Q16_ONE;
+    shape->dead_band = dead_band;
+
+    for ( i = 0; i < ACTUATOR_TABLE_POINTS; i++ )
+    {
+        shape->thrust_table [ i ] = ( uint32_t ) lround ( PWM_Q16_ONE * sqrt (( double ) i / ( ACTUATOR_TABLE_POINTS - 1 )));
+    }
+}
+
+/**
+ * Drives both channels from 0 to full and back with the default shaping
+ * and checks every update moves by the rate limit
+ */
+static void
+testRateLimits ( void )
+{
+    uint32_t last [ NUM_ACTUATORS ] = { 0, 0 };
+    uint32_t update;
+    uint8_t channel;
+
+    initActuator ();
+
+    for ( update = 0; update < 120; update++ )
+    {
+        applyActuatorCommand ( PWM_Q16_ONE, PWM_Q16_ONE );
+
+        for ( channel = 0; channel < NUM_ACTUATORS; channel++ )
+        {
+            uint32_t step = ( channel == ACTUATOR_MAIN ) ? MAIN_STEP : TAIL_STEP;
+            uint32_t expected = ( last [ channel ] + step < PWM_Q16_ONE ) ? last [ channel ] + step : PWM_Q16_ONE;
+
+            check ( g_staged [ channel ] == expected, channel ? "tail rises at 2 % per update" : "main rises at 1 % per update",
+                    g_staged [ channel ] );
+            last [ channel ] = g_staged [ channel ];
+        }
+    }
+    check ( last [ ACTUATOR_MAIN ] == PWM_Q16_ONE, "main reaches full duty", last [ ACTUATOR_MAIN ] );
+
+    for ( update = 0; update < 120; update++ )
+    {
+        applyActuatorCommand ( 0, 0 );
+
+        for ( channel = 0; channel < NUM_ACTUATORS; channel++ )
+        {
+            uint32_t step = ( channel == ACTUATOR_MAIN ) ? MAIN_STEP : TAIL_STEP;
+            uint32_t expected = ( last [ channel ] > step ) ? last [ channel ] - step : 0;
+
+            check ( g_staged [ channel ] == expected, channel ? "tail falls at 2 % per update" : "main falls at 1 % per update",
+                    g_staged [ channel ] );
+            last [ channel ] = g_staged [ channel ];
+        }
+    }
+    check ( last [ ACTUATOR_MAIN ] == 0 && last [ ACTUATOR_TAIL ] == 0, "both channels reach zero", last [ ACTUATOR_MAIN ] );
+
+    // A command inside the limit is reached in one update
+    applyActuatorCommand ( MAIN_STEP / 2, TAIL_STEP / 2 );
+    check ( g_staged [ ACTUATOR_MAIN ] == MAIN_STEP / 2, "small main change passes", g_staged [ ACTUATOR_MAIN ] );
+    check ( g_staged [ ACTUATOR_TAIL ] == TAIL_STEP / 2, "small tail change passes", g_staged [ ACTUATOR_TAIL ] );
+}
+
+/**
+ * Checks the dead band offsets any thrust above zero and leaves zero off
+ */
+static void
+testDeadBand ( void )
+{
+    actuatorShape_t shape;
+    uint32_t duty;
+
+    makeShape ( &shape, PERCENT_20 );
+
+    check ( shapeCommand ( &shape, 0, 0 ) == 0, "zero thrust stays off", shapeCommand ( &shape, 0, 0 ));
+
+    duty = shapeCommand ( &shape, 0, 1 );
+    check ( duty >= PERCENT_20 && duty <= PERCENT_20 + 1, "least thrust starts at the dead band", duty );
+
+    duty = shapeCommand ( &shape, 0, PWM_Q16_ONE );
+    check ( duty == PWM_Q16_ONE, "full thrust is full duty", duty );
+
+    duty = shapeCommand ( &shape, 0, PWM_Q16_ONE * 3 );
+    check ( duty == PWM_Q16_ONE, "commands past full are clamped", duty );
+
+    // Turning off is still rate limited
+    shape.rate_limit = MAIN_STEP;
+    duty = shapeCommand ( &shape, PERCENT_20, 0 );
+    check ( duty == PERCENT_20 - MAIN_STEP, "turning off is rate limited", duty );
+}
+
+/**
+ * Checks the table is hit exactly at its points, interpolated between them
+ * and that the shaped duty never falls as thrust rises
+ */
+static void
+testThrustTable ( void )
+{
+    actuatorShape_t shape;
+    uint32_t previous = 0;
+    uint32_t command;
+    uint32_t i;
+    bool monotonic = true;
+
+    makeShape ( &shape, 0 );
+
+    for ( i = 1; i < ACTUATOR_TABLE_POINTS; i++ )
+    {
+        uint32_t point = ( uint32_t ) ((( uint64_t ) i << PWM_Q16_SHIFT ) / ( ACTUATOR_TABLE_POINTS - 1 ));
+        uint32_t duty = shapeCommand ( &shape, 0, point );
+        long error = ( long ) duty - ( long ) shape.thrust_table [ i ];
+
+        check ( labs ( error ) <= 1, "table point", error );
+    }
+
+    for ( command = 0; command <= PWM_Q16_ONE; command++ )
+    {
+        uint32_t duty = shapeCommand ( &shape, 0, command );
+
+        if ( duty < previous )
+        {
+            monotonic = false;
+        }
+        previous = duty;
+    }
+    check ( monotonic, "duty rises with thrust", previous );
+}
+
+/**
+ * Compares shapeCommand with the floating point model on random tables,
+ * dead bands, rate limits, last outputs and commands
+ */
+static void
+testAgainstModel ( void )
+{
+    uint32_t random = 0x2545F491;
+    double worst = 0;
+    uint32_t i;
+    uint32_t j;
+
+    for ( i = 0; i < RANDOM_CASES; i++ )
+    {
+        actuatorShape_t shape;
+        uint32_t value = 0;
+        uint32_t last;
+        uint32_t command;
+        double error;
+
+        // A random monotonic table from 0 to full
+        for ( j = 0; j < ACTUATOR_TABLE_POINTS; j++ )
+        {
+            value += nextRandom ( &random ) % ( PWM_Q16_ONE / ( ACTUATOR_TABLE_POINTS - 1 ) * 2 );
+            shape.thrust_table [ j ] = ( j == 0 ) ? 0 : ( value < PWM_Q16_ONE ? value : PWM_Q16_ONE );
+        }
+        shape.thrust_table [ ACTUATOR_TABLE_POINTS - 1 ] = PWM_Q16_ONE;
+        shape.dead_band = nextRandom ( &random ) % ( PWM_Q16_ONE / 2 );
+        shape.rate_limit = 1 + nextRandom ( &random ) % PWM_Q16_ONE;
+        last = nextRandom ( &random ) % ( PWM_Q16_ONE + 1 );
+        command = nextRandom ( &random ) % ( PWM_Q16_ONE + PWM_Q16_ONE / 4 );
+
+        error = fabs ( shapeCommand ( &shape, last, command ) - modelCommand ( &shape, last, command ));
+
+        if ( error > worst )
+        {
+            worst = error;
+        }
+    }
+    check ( worst <= 2, "random cases within two Q16 steps of the model", ( long ) worst );
+    printf ( "%u random cases, worst error %.0f Q16 steps\n", RANDOM_CASES, worst );
+}
+
+/**
+ * Checks both channels are staged before either syncs and the syncs are
+ * issued together with interrupts masked
+ */
+static void
+testSynchronizedApply ( void )
+{
+    uint32_t syncs = g_syncs [ ACTUATOR_MAIN ];
+
+    g_staged_count = 0;
+    applyActuatorCommand ( PWM_Q16_ONE / 4, PWM_Q16_ONE / 4 );
+    check ( g_syncs [ ACTUATOR_MAIN ] == syncs + 1, "one main sync per update", g_syncs [ ACTUATOR_MAIN ] - syncs );
+    check ( g_syncs [ ACTUATOR_MAIN ] == g_syncs [ ACTUATOR_TAIL ], "main and tail synced together",
+            g_syncs [ ACTUATOR_TAIL ] );
+    check ( g_unmasked_syncs == 0, "syncs issued with interrupts masked", g_unmasked_syncs );
+    check ( g_unstaged_syncs == 0, "both channels staged before syncing", g_unstaged_syncs );
+    check ( !g_masked, "interrupts enabled again after the update", g_masked );
+
+    // An update made with interrupts already masked leaves them masked
+    IntMasterDisable ();
+    applyActuatorCommand ( 0, 0 );
+    check ( g_masked, "interrupts stay masked for a masked caller", g_masked );
+    IntMasterEnable ();
+
+    check ( getActuatorOutput ( ACTUATOR_MAIN ) == g_staged [ ACTUATOR_MAIN ], "main output reported as staged",
+            getActuatorOutput ( ACTUATOR_MAIN ));
+    check ( getActuatorOutput ( ACTUATOR_TAIL ) == g_staged [ ACTUATOR_TAIL ], "tail output reported as staged",
+            getActuatorOutput ( ACTUATOR_TAIL ));
+}
+
+int
+main ( void )
+{
+    testRateLimits ();
+    testDeadBand ();
+    testThrustTable ();
+    testAgainstModel ();
+    testSynchronizedApply ();
+
+    printf ( "%u checks, %u failed\n", g_checks, g_failures );
+    return g_failures ? 1 : 0;
+}
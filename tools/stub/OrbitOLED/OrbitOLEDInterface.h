@@ -0,0 +1,16 @@
+/* @file    OrbitOLEDInterface.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Host stand-in for the Orbit OLED driver. The test program
+ *          linking a module provides the functions
+ */
+
+#ifndef ORBITOLEDINTERFACE_H_
+#define ORBITOLEDINTERFACE_H_
+
+#include <stdint.h>
+
+void
+OLEDStringDraw ( char *str, uint32_t col, uint32_t row );
+
+#endif /* ORBITOLEDINTERFACE_H_ */
@@ -0,0 +1,11 @@
+/* @file    adc.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Host stand-in for the TivaWare ADC API. Nothing the host builds
+ *          uses it
+ */
+
+#ifndef ADC_H_
+#define ADC_H_
+
+#endif /* ADC_H_ */
@@ -0,0 +1,15 @@
+/* @file    debug.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Host stand-in for the TivaWare debug macros. ASSERT is always
+ *          checked on the host, as in a DEBUG build of the firmware
+ */
+
+#ifndef DEBUG_H_
+#define DEBUG_H_
+
+#include <assert.h>
+
+#define ASSERT( expr )          assert ( expr )
+
+#endif /* DEBUG_H_ */
@@ -0,0 +1,19 @@
+/* @file    flash.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Host stand-in for the TivaWare flash controller API. The
+ *          test program linking a module provides the functions
+ */
+
+#ifndef FLASH_H_
+#define FLASH_H_
+
+#include <stdint.h>
+
+int32_t
+FlashErase ( uint32_t address );
+
+int32_t
+FlashProgram ( uint32_t *data, uint32_t address, uint32_t count );
+
+#endif /* FLASH_H_ */
@@ -0,0 +1,22 @@
+/* @file    gpio.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Host stand-in for the TivaWare GPIO API. The test program
+ *          linking a module provides the functions
+ */
+
+#ifndef GPIO_H_
+#define GPIO_H_
+
+#include <stdint.h>
+
+#define GPIO_PIN_1              0x00000002
+#define GPIO_PIN_5              0x00000020
+
+void
+GPIOPinConfigure ( uint32_t pin_config );
+
+void
+GPIOPinTypePWM ( uint32_t port, uint8_t pins );
+
+#endif /* GPIO_H_ */
@@ -0,0 +1,19 @@
+/* @file    interrupt.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Host stand-in for the TivaWare interrupt controller API. The
+ *          test program linking a module provides the functions
+ */
+
+#ifndef INTERRUPT_H_
+#define INTERRUPT_H_
+
+#include <stdbool.h>
+
+bool
+IntMasterDisable ( void );
+
+bool
+IntMasterEnable ( void );
+
+#endif /* INTERRUPT_H_ */
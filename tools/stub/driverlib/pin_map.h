@@ -0,0 +1,13 @@
+/* @file    pin_map.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Host stand-in for the TivaWare pin map, the rotor PWM pins only
+ */
+
+#ifndef PIN_MAP_H_
+#define PIN_MAP_H_
+
+#define GPIO_PC5_M0PWM7         0x00021404
+#define GPIO_PF1_M1PWM5         0x00050405
+
+#endif /* PIN_MAP_H_ */
@@ -0,0 +1,47 @@
+/* @file    pwm.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Host stand-in for the TivaWare PWM API. The test program
+ *          linking a module provides the functions
+ */
+
+#ifndef PWM_H_
+#define PWM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define PWM_GEN_2               0x000000C0
+#define PWM_GEN_3               0x00000100
+#define PWM_GEN_2_BIT           0x00000004
+#define PWM_GEN_3_BIT           0x00000008
+#define PWM_OUT_5               0x000000C1
+#define PWM_OUT_7               0x00000103
+#define PWM_OUT_5_BIT           0x00000020
+#define PWM_OUT_7_BIT           0x00000080
+#define PWM_GEN_MODE_UP_DOWN    0x00000002
+#define PWM_GEN_MODE_SYNC       0x0000003A
+#define PWM_GEN_MODE_GEN_SYNC_GLOBAL 0x00000028
+
+void
+PWMGenConfigure ( uint32_t base, uint32_t gen, uint32_t config );
+
+void
+PWMGenPeriodSet ( uint32_t base, uint32_t gen, uint32_t period );
+
+void
+PWMGenEnable ( uint32_t base, uint32_t gen );
+
+void
+PWMPulseWidthSet ( uint32_t base, uint32_t out, uint32_t width );
+
+uint32_t
+PWMGenPeriodGet ( uint32_t base, uint32_t gen );
+
+void
+PWMSyncUpdate ( uint32_t base, uint32_t gen_bits );
+
+void
+PWMOutputState ( uint32_t base, uint32_t out_bits, bool enable );
+
+#endif /* PWM_H_ */
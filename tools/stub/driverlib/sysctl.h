@@ -0,0 +1,25 @@
+/* @file    sysctl.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Host stand-in for the TivaWare system control API. The test
+ *          program linking a module provides the functions
+ */
+
+#ifndef SYSCTL_H_
+#define SYSCTL_H_
+
+#include <stdint.h>
+
+#define SYSCTL_PERIPH_PWM0      0xF0004000
+#define SYSCTL_PERIPH_PWM1      0xF0004001
+#define SYSCTL_PERIPH_GPIOC     0xF0000802
+#define SYSCTL_PERIPH_GPIOF     0xF0000805
+#define SYSCTL_PWMDIV_1         0x00000000
+
+void
+SysCtlPeripheralEnable ( uint32_t peripheral );
+
+uint32_t
+SysCtlClockGet ( void );
+
+#endif /* SYSCTL_H_ */
@@ -0,0 +1,11 @@
+/* @file    systick.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Host stand-in for the TivaWare SysTick API. Nothing the host
+ *          builds uses it
+ */
+
+#ifndef SYSTICK_H_
+#define SYSTICK_H_
+
+#endif /* SYSTICK_H_ */
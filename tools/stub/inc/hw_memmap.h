@@ -0,0 +1,17 @@
+/* @file    hw_memmap.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Host stand-in for the TivaWare peripheral base addresses, for
+ *          building firmware modules into the tools/ test programs
+ */
+
+#ifndef HW_MEMMAP_H_
+#define HW_MEMMAP_H_
+
+#define PWM0_BASE               0x40028000
+#define PWM1_BASE               0x40029000
+#define UART0_BASE              0x4000C000
+#define GPIO_PORTC_BASE         0x40006000
+#define GPIO_PORTF_BASE         0x40025000
+
+#endif /* HW_MEMMAP_H_ */
@@ -0,0 +1,11 @@
+/* @file    hw_types.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Host stand-in for the TivaWare hardware types header. Nothing
+ *          the host builds uses it
+ */
+
+#ifndef HW_TYPES_H_
+#define HW_TYPES_H_
+
+#endif /* HW_TYPES_H_ */
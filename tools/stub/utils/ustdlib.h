@@ -0,0 +1,32 @@
+/* @file    ustdlib.h
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Host stand-in for the TivaWare ustdlib header, declaring the
+ *          functions of ustdlib.c with the TivaWare signatures
+ */
+
+#ifndef USTDLIB_H_
+#define USTDLIB_H_
+
+#include <stddef.h>
+#include <stdarg.h>
+#include <time.h>
+
+void ulocaltime ( time_t timer, struct tm *tm );
+time_t umktime ( struct tm *timeptr );
+int usnprintf ( char * restrict s, size_t n, const char * restrict format, ... );
+int usprintf ( char * restrict s, const char *format, ... );
+void usrand ( unsigned int seed );
+int ustrcasecmp ( const char *s1, const char *s2 );
+int ustrcmp ( const char *s1, const char *s2 );
+size_t ustrlen ( const char *s );
+int ustrncasecmp ( const char *s1, const char *s2, size_t n );
+int ustrncmp ( const char *s1, const char *s2, size_t n );
+char *ustrncpy ( char * restrict s1, const char * restrict s2, size_t n );
+char *ustrstr ( const char *s1, const char *s2 );
+float ustrtof ( const char *nptr, const char **endptr );
+unsigned long ustrtoul ( const char * restrict nptr, const char ** restrict endptr, int base );
+int urand ( void );
+int uvsnprintf ( char * restrict s, size_t n, const char * restrict format, va_list arg );
+
+#endif /* USTDLIB_H_ */
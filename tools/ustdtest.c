@@ -0,0 +1,692 @@
+/* @file    ustdtest.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Linux check of ustdlib.c against glibc. Compares uvsnprintf,
+ *          ustrtoul, ustrtof, ustrncmp, ulocaltime and umktime with their
+ *          C library counterparts on random inputs, replays the bugs fixed
+ *          so far and reports ns/op for the call shapes the firmware uses
+ *
+ * Build:   gcc -O2 -funsigned-char -Itools/stub -o ustdtest tools/ustdtest.c ustdlib.c -lm
+ * Fuzz:    gcc -O1 -g -funsigned-char -fsanitize=address,undefined -Itools/stub \
+ *              -o ustdtest tools/ustdtest.c ustdlib.c -lm
+ * Usage:   ustdtest [-n cases] [-s seed]
+ *
+ * Every output buffer and format string is allocated to its exact size, so
+ * under AddressSanitizer a read or write one byte past either is reported.
+ * char is unsigned on the Cortex-M4, so the host build must match it.
+ * Inputs stay within what the firmware relies on and where TivaWare
+ * documents its own behaviour; each generator notes what it leaves out.
+ * Timings from a sanitizer build are not meaningful. Exits 1 if any check
+ * fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include <float.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include "utils/ustdlib.h"
+
+#if CHAR_MIN != 0
+#error "build with -funsigned-char, char is unsigned on the Cortex-M4"
+#endif
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define DEFAULT_CASES           1000000
+#define MAX_PIECES              6               // Literal runs and conversions per format
+#define MAX_ARGS                4               // Conversions taking an argument per format
+#define TEXT_SIZE               256
+#define MAX_BUFFER              48              // Largest usnprintf buffer
+#define LAST_TIME               4107542399UL    // 2100-02-28 23:59:59, ulocaltime has no 2100 rule
+#define STRTOF_TOLERANCE        1e-6            // Largest relative error of ustrtof
+#define STRTOF_EXACT_EXPONENT   30              // Larger exponents are only checked for overflow
+#define BENCH_CALLS             2000000
+#define FAILURES_SHOWN          10
+
+/**********************************************************
+ * Global variables
+ **********************************************************/
+
+static uint32_t g_checks = 0;
+static uint32_t g_failures = 0;
+static uint64_t g_random = 1;
+
+/**
+ * Counts one check and reports it if it failed
+ * @param passed    Result of the check
+ * @param name      What was checked
+ * @param detail    The input, printed on failure
+ */
+static void
+check ( bool passed, const char *name, const char *detail )
+{
+    ++g_checks;
+
+    if ( !passed && ++g_failures <= FAILURES_SHOWN )
+    {
+        fprintf ( stderr, "FAIL %s: %s\n", name, detail );
+    }
+}
+
+/**
+ * Returns the next value of a splitmix64 generator
+ * @return  64 random bits
+ */
+static uint64_t
+nextRandom ( void )
+{
+    uint64_t z = ( g_random += 0x9E3779B97F4A7C15ULL );
+
+    z = ( z ^ ( z >> 30 )) * 0xBF58476D1CE4E5B9ULL;
+    z = ( z ^ ( z >> 27 )) * 0x94D049BB133111EBULL;
+    return z ^ ( z >> 31 );
+}
+
+/**
+ * Returns a random value below a limit
+ * @param limit The limit, above zero
+ * @return      The value
+ */
+static uint32_t
+below ( uint32_t limit )
+{
+    return nextRandom () % limit;
+}
+
+/**
+ * Returns a random 32 bit value, biased towards small values and the edges
+ * @return  The value
+ */
+static uint32_t
+randomValue ( void )
+{
+    static const uint32_t edges [] = { 0, 1, 9, 10, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFF, 0xFFFFFFF6 };
+
+    switch ( below ( 4 ))
+    {
+    case 0:
+        return edges [ below ( sizeof ( edges ) / sizeof ( edges [ 0 ] )) ];
+    case 1:
+        return below ( 1000 ) - 500;
+    default:
+        return ( uint32_t ) nextRandom ();
+    }
+}
+
+/**
+ * Appends random printable characters other than '%'
+ * @param text  Destination, null terminated on return
+ * @param count Number of characters
+ * @return      The end of the text
+ */
+static char *
+appendText ( char *text, uint32_t count )
+{
+    while ( count-- )
+    {
+        char c = ' ' + below ( 95 );
+
+        *text++ = ( c == '%' ) ? '#' : c;
+    }
+    *text = '\0';
+    return text;
+}
+
+/**
+ * Returns a copy of a string in a block of exactly its size
+ * @param text  The string
+ * @return      The copy
+ */
+static char *
+exactCopy ( const char *text )
+{
+    size_t size = strlen ( text ) + 1;
+
+    return memcpy ( malloc ( size ), text, size );
+}
+
+/**
+ * Formats with usnprintf and snprintf into exactly sized buffers and
+ * compares the text and the returned counts
+ * @param n         Buffer size
+ * @param format    usnprintf format
+ * @param reference The same output as a glibc format
+ * @param args      Arguments, all passed as unsigned long as ustdlib reads
+ *                  them; strings are passed as pointers of the same width
+ * @param name      What was checked
+ */
+static void
+comparePrintf ( size_t n, const char *format, const char *reference, const unsigned long *args, const char *name )
+{
+    char *exact_format = exactCopy ( format );
+    char *ours = malloc ( n );
+    char *theirs = malloc ( n );
+    char detail [ 3 * TEXT_SIZE ];
+    int our_count = usnprintf ( ours, n, exact_format, args [ 0 ], args [ 1 ], args [ 2 ], args [ 3 ] );
+    int their_count = snprintf ( theirs, n, reference, args [ 0 ], args [ 1 ], args [ 2 ], args [ 3 ] );
+
+    snprintf ( detail, sizeof ( detail ), "\"%s\" n %zu: \"%s\" %d, glibc \"%s\" %d", format, n, ours, our_count,
+               theirs, their_count );
+    check ( our_count == their_count && strcmp ( ours, theirs ) == 0, name, detail );
+    free ( theirs );
+    free ( ours );
+    free ( exact_format );
+}
+
+/**
+ * Replays the bugs found by earlier fuzzing, and by this program
+ */
+static void
+testRegressions ( void )
+{
+    static const char torn_format [] = "ab%\0X%d";
+    unsigned long args [ MAX_ARGS ] = { 0 };
+    struct tm epoch = { 0 };
+    const char *end;
+    char detail [ TEXT_SIZE ];
+    char text [ 16 ];
+    float value;
+
+    // %s with a field width set the space left to minus the padding, so the
+    // next conversion wrote past the end of the buffer
+    args [ 0 ] = ( unsigned long ) "ab";
+    args [ 1 ] = ( unsigned long ) "cdefghijklmnopqrstuvwxyz";
+    comparePrintf ( 12, "%8s|%s", "%-8s|%s", args, "padded %s then %s" );
+
+    // A '%' at the end of the format consumed the terminator and parsing
+    // carried on past it
+    check ( usnprintf ( text, sizeof ( text ), torn_format, 5UL ) == 7 && strcmp ( text, "abERROR" ) == 0,
+            "'%' at the end of the format", text );
+    comparePrintf ( 8, "ab%", "abERROR", args, "'%' at the end of an exact format" );
+
+    // The minus sign was not counted once the buffer was full
+    args [ 0 ] = ( unsigned long ) -5L;
+    comparePrintf ( 1, "%d", "%ld", args, "minus sign with no room" );
+    comparePrintf ( 1, "%05d", "%05ld", args, "zero filled minus sign with no room" );
+    comparePrintf ( 2, "%4d", "%4ld", args, "padded minus sign with no room" );
+
+    // An exponent of 64 or more read past the table of powers of ten
+    value = ustrtof ( "1e64", &end );
+    snprintf ( detail, sizeof ( detail ), "1e64 gave %g", value );
+    check ( isinf ( value ) && *end == '\0', "exponent past the power table", detail );
+    value = ustrtof ( "1e-64", &end );
+    snprintf ( detail, sizeof ( detail ), "1e-64 gave %g", value );
+    check ( value == 0 && *end == '\0', "negative exponent past the power table", detail );
+
+    // A zero mantissa times an overflowed power of ten gave NaN
+    value = ustrtof ( "0e39", &end );
+    snprintf ( detail, sizeof ( detail ), "0e39 gave %g", value );
+    check ( value == 0 && !signbit ( value ), "zero with an overflowing exponent", detail );
+
+    // The binary search never reached the epoch itself
+    epoch.tm_year = 70;
+    epoch.tm_mday = 1;
+    snprintf ( detail, sizeof ( detail ), "1970-01-01 gave %lld", ( long long ) umktime ( &epoch ));
+    check ( umktime ( &epoch ) == 0, "umktime of the epoch", detail );
+
+    // A bare 0x prefix rejected the whole number instead of reading the 0
+    check ( ustrtoul ( "0x", &end, 16 ) == 0 && *end == 'x', "bare 0x prefix", "0x" );
+    check ( ustrtoul ( "0xg", &end, 0 ) == 0 && *end == 'x', "0x prefix without a digit", "0xg" );
+}
+
+/**
+ * Compares usnprintf with snprintf on random formats, values and buffer
+ * sizes. Leaves out what TivaWare documents as its own behaviour: widths
+ * on %c and %%, upper case hex for %X, and %p
+ * @param cases Number of formats
+ */
+static void
+fuzzPrintf ( uint32_t cases )
+{
+    static const char conversions [] = "cdiusxX%q";
+
+    while ( cases-- )
+    {
+        char format [ TEXT_SIZE ];
+        char reference [ TEXT_SIZE ];
+        char strings [ MAX_ARGS ] [ 16 ];
+        unsigned long args [ MAX_ARGS ] = { 0 };
+        char *f = format;
+        char *r = reference;
+        uint32_t used = 0;
+        uint32_t pieces = 1 + below ( MAX_PIECES );
+        uint32_t i;
+
+        for ( i = 0; i < pieces; i++ )
+        {
+            char conversion = conversions [ below ( sizeof ( conversions ) - 1 ) ];
+            const char *flag = below ( 3 ) ? "" : "0";
+            int width = below ( 2 ) ? ( int ) below ( 16 ) : -1;
+            char spec [ 8 ] = "";
+
+            if ( below ( 2 ) || used == MAX_ARGS )
+            {
+                uint32_t length = below ( 6 );
+
+                appendText ( f, length );
+                r = stpcpy ( r, f );
+                f += length;
+                continue;
+            }
+
+            if ( width >= 0 )
+            {
+                snprintf ( spec, sizeof ( spec ), "%s%d", flag, width );
+            }
+            f += sprintf ( f, "%%%s%c", spec, conversion );
+
+            switch ( conversion )
+            {
+            case 'c':
+                args [ used++ ] = ' ' + 1 + below ( 94 );
+                r = stpcpy ( r, "%c" );
+                break;
+            case 'd':
+            case 'i':
+                args [ used++ ] = ( unsigned long ) ( long ) ( int32_t ) randomValue ();
+                r += sprintf ( r, "%%%sld", spec );
+                break;
+            case 'u':
+                args [ used++ ] = randomValue ();
+                r += sprintf ( r, "%%%slu", spec );
+                break;
+            case 'x':
+            case 'X':
+                args [ used++ ] = randomValue ();
+                r += sprintf ( r, "%%%slx", spec );
+                break;
+            case 's':
+                // Strings are padded on the right with spaces
+                appendText ( strings [ used ], below ( 12 ));
+                args [ used ] = ( unsigned long ) strings [ used ];
+                ++used;
+                r += sprintf ( r, "%%-%ds", width > 0 ? width : 0 );
+                break;
+            case '%':
+                // Any width is dropped
+                r = stpcpy ( r, "%%" );
+                break;
+            default:
+                r = stpcpy ( r, "ERROR" );
+                break;
+            }
+        }
+
+        // Sometimes ends on a lone '%'
+        if ( below ( 16 ) == 0 )
+        {
+            f = stpcpy ( f, "%" );
+            r = stpcpy ( r, "ERROR" );
+        }
+        comparePrintf ( 1 + below ( MAX_BUFFER ), format, reference, args, "usnprintf" );
+    }
+}
+
+/**
+ * Compares ustrtoul with strtoul on random numbers in every base.
+ * Leaves out what the firmware never sends: white space other than space
+ * and tab, and values outside 32 bits, where strtoul saturates but the
+ * target wraps
+ * @param cases Number of strings
+ */
+static void
+fuzzStrtoul ( uint32_t cases )
+{
+    static const char digits [] = "0123456789abcdefABCDEFgGzZ";
+    uint32_t skipped = 0;
+
+    while ( cases-- )
+    {
+        char text [ 40 ];
+        char detail [ TEXT_SIZE ];
+        char *t = text;
+        int base = below ( 3 ) ? ( int [] ) { 0, 8, 10, 16 } [ below ( 4 ) ] : 2 + ( int ) below ( 15 );
+        uint32_t count = below ( 12 );
+        const char *our_end;
+        char *their_end;
+        unsigned long ours;
+        unsigned long theirs;
+        unsigned long magnitude;
+
+        while ( below ( 4 ) == 0 )
+        {
+            *t++ = below ( 2 ) ? ' ' : '\t';
+        }
+
+        if ( below ( 3 ) == 0 )
+        {
+            *t++ = below ( 2 ) ? '-' : '+';
+        }
+
+        if (( base == 0 || base == 16 ) && below ( 3 ) == 0 )
+        {
+            t = stpcpy ( t, below ( 2 ) ? "0x" : "0X" );
+        }
+
+        while ( count-- )
+        {
+            *t++ = digits [ below ( base == 10 ? 10 : sizeof ( digits ) - 1 ) ];
+        }
+        *t = '\0';
+
+        theirs = strtoul ( text, &their_end, base );
+        magnitude = strchr ( text, '-' ) && their_end != text ? -theirs : theirs;
+
+        if ( magnitude > UINT32_MAX )
+        {
+            ++skipped;
+            continue;
+        }
+        ours = ustrtoul ( text, &our_end, base );
+
+        snprintf ( detail, sizeof ( detail ), "\"%s\" base %d: %lu end %td, glibc %lu end %td", text, base, ours,
+                   our_end - text, theirs, their_end - text );
+        check ( ours == theirs && our_end == their_end, "ustrtoul", detail );
+    }
+    printf ( "  ustrtoul: %u past 32 bits skipped\n", skipped );
+}
+
+/**
+ * Compares ustrtof with strtod rounded to float on random decimal numbers.
+ * Values with an exponent up to STRTOF_EXACT_EXPONENT must match within
+ * STRTOF_TOLERANCE. Past that, ustrtof builds the power of ten before
+ * applying it, so only overflow to infinity and underflow to zero are
+ * checked. Leaves out "inf", "nan", hex floats, and a '.' with no digit
+ * after it, which TivaWare does not take as part of the number
+ * @param cases Number of strings
+ */
+static void
+fuzzStrtof ( uint32_t cases )
+{
+    double worst = 0;
+
+    while ( cases-- )
+    {
+        char text [ 48 ];
+        char detail [ TEXT_SIZE ];
+        char *t = text;
+        uint32_t exponent = 0;
+        const char *our_end;
+        char *their_end;
+        double theirs;
+        float ours;
+
+        while ( below ( 4 ) == 0 )
+        {
+            *t++ = below ( 2 ) ? ' ' : '\t';
+        }
+
+        if ( below ( 3 ) == 0 )
+        {
+            *t++ = below ( 2 ) ? '-' : '+';
+        }
+
+        // Up to 9 digits, then a fraction of up to 8
+        for ( uint32_t count = below ( 10 ); count; count-- )
+        {
+            *t++ = '0' + below ( 10 );
+        }
+
+        if ( below ( 2 ))
+        {
+            *t++ = '.';
+
+            for ( uint32_t count = 1 + below ( 8 ); count; count-- )
+            {
+                *t++ = '0' + below ( 10 );
+            }
+        }
+
+        // An exponent, sometimes malformed, sometimes past the float range
+        if ( below ( 2 ))
+        {
+            *t++ = below ( 2 ) ? 'e' : 'E';
+
+            if ( below ( 2 ))
+            {
+                *t++ = below ( 2 ) ? '-' : '+';
+            }
+
+            if ( below ( 8 ))
+            {
+                exponent = below ( 4 ) ? below ( STRTOF_EXACT_EXPONENT + 1 ) : below ( 100 );
+                t += sprintf ( t, below ( 8 ) ? "%u" : "00%u", exponent );
+            }
+        }
+
+        if ( below ( 4 ) == 0 )
+        {
+            *t++ = "eE+-xa" [ below ( 6 ) ];
+        }
+        *t = '\0';
+
+        theirs = ( float ) strtod ( text, &their_end );
+        ours = ustrtof ( text, &our_end );
+        snprintf ( detail, sizeof ( detail ), "\"%s\": %.9g end %td, glibc %.9g end %td", text, ours,
+                   our_end - text, theirs, their_end - text );
+        check ( our_end == their_end, "ustrtof end", detail );
+
+        if ( isinf ( theirs ) || theirs == 0 )
+        {
+            check ( ours == theirs, "ustrtof overflow", detail );
+        } else if ( fabs ( theirs ) < FLT_MIN )
+        {
+            check ( fabs ( ours - theirs ) <= FLT_MIN, "ustrtof underflow", detail );
+        } else if ( exponent <= STRTOF_EXACT_EXPONENT )
+        {
+            double error = fabs ( ours - theirs ) / fabs ( theirs );
+
+            worst = ( error > worst ) ? error : worst;
+            check ( error <= STRTOF_TOLERANCE, "ustrtof", detail );
+        }
+    }
+    printf ( "  ustrtof: worst relative error %.2g, limit %.2g\n", worst, STRTOF_TOLERANCE );
+}
+
+/**
+ * Compares ustrncmp with strncmp on short strings over a small alphabet,
+ * so prefixes and equal runs are common, including bytes above 0x7F
+ * @param cases Number of pairs
+ */
+static void
+fuzzStrncmp ( uint32_t cases )
+{
+    static const char alphabet [] = "aab\x80\xff";
+
+    while ( cases-- )
+    {
+        char first [ 8 ];
+        char second [ 8 ];
+        char detail [ TEXT_SIZE ];
+        size_t n = below ( 9 );
+        uint32_t length;
+        uint32_t i;
+        int ours;
+        int theirs;
+
+        for ( length = below ( 7 ), i = 0; i < length; i++ )
+        {
+            first [ i ] = alphabet [ below ( sizeof ( alphabet ) - 1 ) ];
+        }
+        first [ length ] = '\0';
+
+        for ( length = below ( 7 ), i = 0; i < length; i++ )
+        {
+            second [ i ] = alphabet [ below ( sizeof ( alphabet ) - 1 ) ];
+        }
+        second [ length ] = '\0';
+
+        ours = ustrncmp ( first, second, n );
+        theirs = strncmp ( first, second, n );
+        snprintf ( detail, sizeof ( detail ), "\"%s\" \"%s\" n %zu: %d, glibc %d", first, second, n, ours, theirs );
+        check (( ours > 0 ) == ( theirs > 0 ) && ( ours < 0 ) == ( theirs < 0 ), "ustrncmp", detail );
+    }
+}
+
+/**
+ * Compares ulocaltime with gmtime_r, and umktime with the time gmtime_r
+ * started from, from the epoch to the end of February 2100. ulocaltime
+ * treats 2100 as a leap year, so later times are left out. umktime does
+ * not normalize out of range fields as timegm does, it returns -1
+ * @param cases Number of times
+ */
+static void
+fuzzTime ( uint32_t cases )
+{
+    static const unsigned long edges [] = { 0, 1, 59, 86399, 86400, 951782400, 951868799, 2147483647, 2147483648UL,
+                                            4107456000UL, LAST_TIME };
+    struct tm invalid = { .tm_year = 121, .tm_mon = 1, .tm_mday = 30 };
+    uint32_t i;
+
+    for ( i = 0; i < cases; i++ )
+    {
+        unsigned long seconds = ( i < sizeof ( edges ) / sizeof ( edges [ 0 ] )) ? edges [ i ]
+                                : nextRandom () % ( LAST_TIME + 1 );
+        time_t timer = seconds;
+        struct tm ours;
+        struct tm theirs;
+        char detail [ TEXT_SIZE ];
+
+        memset ( &ours, 0, sizeof ( ours ));
+        ulocaltime ( timer, &ours );
+        gmtime_r ( &timer, &theirs );
+
+        snprintf ( detail, sizeof ( detail ), "%lu: %d-%02d-%02d %02d:%02d:%02d day %d, glibc %d-%02d-%02d "
+                   "%02d:%02d:%02d day %d", seconds, ours.tm_year + 1900, ours.tm_mon + 1, ours.tm_mday,
+                   ours.tm_hour, ours.tm_min, ours.tm_sec, ours.tm_wday, theirs.tm_year + 1900, theirs.tm_mon + 1,
+                   theirs.tm_mday, theirs.tm_hour, theirs.tm_min, theirs.tm_sec, theirs.tm_wday );
+        check ( ours.tm_year == theirs.tm_year && ours.tm_mon == theirs.tm_mon && ours.tm_mday == theirs.tm_mday
+                && ours.tm_hour == theirs.tm_hour && ours.tm_min == theirs.tm_min && ours.tm_sec == theirs.tm_sec
+                && ours.tm_wday == theirs.tm_wday, "ulocaltime", detail );
+        check ( umktime ( &theirs ) == timer, "umktime", detail );
+    }
+    check ( umktime ( &invalid ) == ( time_t ) -1, "umktime of 30 February", "2021-02-30" );
+}
+
+/**
+ * Returns a monotonic time
+ * @return  Nanoseconds
+ */
+static double
+now ( void )
+{
+    struct timespec time;
+
+    clock_gettime ( CLOCK_MONOTONIC, &time );
+    return time.tv_sec * 1e9 + time.tv_nsec;
+}
+
+// Times BENCH_CALLS runs of a statement, leaving ns/op in the named variable
+#define BENCH( result, statement )                                      \
+    do                                                                  \
+    {                                                                   \
+        double start = now ();                                          \
+        for ( i = 0; i < BENCH_CALLS; i++ )                             \
+        {                                                               \
+            statement;                                                  \
+        }                                                               \
+        result = ( now () - start ) / BENCH_CALLS;                      \
+    } while ( 0 )
+
+/**
+ * Prints ns/op of ustdlib and glibc for the call shapes the firmware uses
+ */
+static void
+benchmark ( void )
+{
+    static const char *const numbers [] = { "12", "-340", "1000", "7" };
+    static const char *const floats [] = { "0.0125", "1.5", "-0.25", "2e-3" };
+    static const char *const words [] = { "alt", "yaw", "gain", "save" };
+    volatile unsigned long sink = 0;
+    char text [ 64 ];
+    const char *end;
+    char *their_end;
+    struct tm tm;
+    time_t timer;
+    double ours;
+    double theirs;
+    uint32_t i;
+
+    printf ( "%-36s %10s %10s\n", "call", "ustdlib", "glibc" );
+
+    BENCH ( ours, sink += usnprintf ( text, sizeof ( text ), "%d", ( unsigned long ) ( long ) ( i % 720 ) - 360 ));
+    BENCH ( theirs, sink += snprintf ( text, sizeof ( text ), "%ld", ( long ) ( i % 720 ) - 360 ));
+    printf ( "%-36s %7.1f ns %7.1f ns\n", "snprintf \"%d\"", ours, theirs );
+
+    BENCH ( ours, sink += usnprintf ( text, sizeof ( text ), "yaw: %4d ", ( unsigned long ) ( long ) ( i % 720 ) - 360 ));
+    BENCH ( theirs, sink += snprintf ( text, sizeof ( text ), "yaw: %4ld ", ( long ) ( i % 720 ) - 360 ));
+    printf ( "%-36s %7.1f ns %7.1f ns\n", "snprintf \"yaw: %4d \"", ours, theirs );
+
+    BENCH ( ours, sink += usnprintf ( text, sizeof ( text ), "Yaw reference at %d ticks in %d ms\r\n",
+                                      ( unsigned long ) ( i & 511 ), ( unsigned long ) i ));
+    BENCH ( theirs, sink += snprintf ( text, sizeof ( text ), "Yaw reference at %ld ticks in %ld ms\r\n",
+                                       ( long ) ( i & 511 ), ( long ) i ));
+    printf ( "%-36s %7.1f ns %7.1f ns\n", "snprintf two %d and text", ours, theirs );
+
+    BENCH ( ours, sink += usnprintf ( text, sizeof ( text ), "%s %08x", words [ i & 3 ], ( unsigned long ) i ));
+    BENCH ( theirs, sink += snprintf ( text, sizeof ( text ), "%s %08lx", words [ i & 3 ], ( unsigned long ) i ));
+    printf ( "%-36s %7.1f ns %7.1f ns\n", "snprintf \"%s %08x\"", ours, theirs );
+
+    BENCH ( ours, sink += ustrtoul ( numbers [ i & 3 ], &end, 10 ));
+    BENCH ( theirs, sink += strtoul ( numbers [ i & 3 ], &their_end, 10 ));
+    printf ( "%-36s %7.1f ns %7.1f ns\n", "strtoul base 10", ours, theirs );
+
+    BENCH ( ours, sink += ( unsigned long ) ( ustrtof ( floats [ i & 3 ], &end ) * 1000 ));
+    BENCH ( theirs, sink += ( unsigned long ) ( strtof ( floats [ i & 3 ], &their_end ) * 1000 ));
+    printf ( "%-36s %7.1f ns %7.1f ns\n", "strtof gain", ours, theirs );
+
+    BENCH ( ours, sink += ustrncmp ( words [ i & 3 ], "gain", 5 ));
+    BENCH ( theirs, sink += strncmp ( words [ i & 3 ], "gain", 5 ));
+    printf ( "%-36s %7.1f ns %7.1f ns\n", "strncmp command word", ours, theirs );
+
+    BENCH ( ours, timer = 1700000000 + i * 977; ulocaltime ( timer, &tm ); sink += tm.tm_mday );
+    BENCH ( theirs, timer = 1700000000 + i * 977; gmtime_r ( &timer, &tm ); sink += tm.tm_mday );
+    printf ( "%-36s %7.1f ns %7.1f ns\n", "localtime / gmtime_r", ours, theirs );
+
+    BENCH ( ours, timer = 1700000000 + i * 977; gmtime_r ( &timer, &tm ); sink += umktime ( &tm ));
+    BENCH ( theirs, timer = 1700000000 + i * 977; gmtime_r ( &timer, &tm ); sink += timegm ( &tm ));
+    printf ( "%-36s %7.1f ns %7.1f ns\n", "mktime / timegm, after gmtime_r", ours, theirs );
+}
+
+int
+main ( int argc, char **argv )
+{
+    uint32_t cases = DEFAULT_CASES;
+    int opt;
+
+    while (( opt = getopt ( argc, argv, "n:s:" )) != -1 )
+    {
+        switch ( opt )
+        {
+        case 'n':
+            cases = strtoul ( optarg, NULL, 10 );
+            break;
+        case 's':
+            g_random = strtoull ( optarg, NULL, 10 );
+            break;
+        default:
+            fprintf ( stderr, "usage: %s [-n cases] [-s seed]\n", argv [ 0 ] );
+            return 2;
+        }
+    }
+
+    printf ( "%u cases per function, seed %llu\n", cases, ( unsigned long long ) g_random );
+    testRegressions ();
+    fuzzPrintf ( cases );
+    fuzzStrtoul ( cases );
+    fuzzStrtof ( cases );
+    fuzzStrncmp ( cases );
+    fuzzTime ( cases );
+    printf ( "%u checks, %u failed\n\n", g_checks, g_failures );
+
+    benchmark ();
+    return g_failures ? 1 : 0;
+}
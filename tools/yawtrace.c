@@ -0,0 +1,208 @@
+/* @file    yawtrace.c
+ * @author  Gus Ellerm, Andrew Limmer-Wood, Adam Ross
+ * @date    19/10/2026
+ * @brief   Linux decoder for the yaw edge trace sent by dumpYawTrace
+ *
+ * Build:   gcc -O2 -o yawtrace tools/yawtrace.c
+ * Usage:   yawtrace [-g glitch_us] [-v out.vcd] dump.bin
+ *
+ * Prints the reconstructed PB0/PB1/PC4 waveform one edge per line and
+ * flags glitches (edges closer than glitch_us on the same source), missed
+ * transitions (a quadrature edge with no level change) and illegal state
+ * jumps (both quadrature channels changing between edges).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include "../yaw.h"
+
+/**********************************************************
+ * Defined constants
+ **********************************************************/
+
+#define DEFAULT_GLITCH_US       2.0     // Edges closer than this are glitches
+#define QUAD_PINS               ( YAW_TRACE_PIN_A | YAW_TRACE_PIN_B )
+
+/**
+ * Scans forward to the trace header and reads it
+ * @param file      The dump
+ * @param header    Destination for the header
+ * @return          True if a header was found
+ */
+static bool
+readHeader ( FILE *file, yawTraceHeader_t *header )
+{
+    uint32_t window = 0;
+    int byte;
+
+    // Skips any text telemetry sent ahead of the dump
+    while (( byte = fgetc ( file )) != EOF )
+    {
+        window = ( window >> 8 ) | (( uint32_t ) byte << 24 );
+
+        if ( window == YAW_TRACE_MAGIC )
+        {
+            header->magic = window;
+            return fread ( &header->clock_hz, sizeof ( *header ) - sizeof ( header->magic ), 1, file ) == 1;
+        }
+    }
+    return false;
+}
+
+/**
+ * Writes the edges as a value change dump for a waveform viewer
+ * @param path      Output file
+ * @param edges     The edges
+ * @param count     Number of edges
+ * @param clock_hz  CPU clock of the timestamps
+ */
+static void
+writeVCD ( const char *path, const yawTrace_t *edges, uint32_t count, uint32_t clock_hz )
+{
+    FILE *vcd = fopen ( path, "w" );
+    uint64_t time = 0;
+    uint32_t i;
+
+    if ( !vcd )
+    {
+        perror ( path );
+        return;
+    }
+    fprintf ( vcd, "$timescale 1 ns $end\n$scope module yaw $end\n" );
+    fprintf ( vcd, "$var wire 1 a PB0 $end\n$var wire 1 b PB1 $end\n$var wire 1 r PC4 $end\n" );
+    fprintf ( vcd, "$upscope $end\n$enddefinitions $end\n" );
+
+    for ( i = 0; i < count; i++ )
+    {
+        if ( i > 0 )
+        {
+            time += ( uint32_t ) ( edges [ i ].time - edges [ i - 1 ].time );
+        }
+        fprintf ( vcd, "#%llu\n%da\n%db\n%dr\n",
+                  ( unsigned long long ) ( time * 1000000000ull / clock_hz ),
+                  ( edges [ i ].pins & YAW_TRACE_PIN_A ) != 0,
+                  ( edges [ i ].pins & YAW_TRACE_PIN_B ) != 0,
+                  ( edges [ i ].pins & YAW_TRACE_PIN_REF ) != 0 );
+    }
+    fclose ( vcd );
+}
+
+int
+main ( int argc, char **argv )
+{
+    double glitch_us = DEFAULT_GLITCH_US;
+    const char *vcd_path = NULL;
+    yawTraceHeader_t header;
+    yawTrace_t *edges;
+    uint32_t glitches = 0;
+    uint32_t missed = 0;
+    uint32_t illegal = 0;
+    int32_t net = 0;
+    uint32_t i;
+    FILE *file;
+    int opt;
+
+    while (( opt = getopt ( argc, argv, "g:v:" )) != -1 )
+    {
+        switch ( opt )
+        {
+        case 'g':
+            glitch_us = atof ( optarg );
+            break;
+        case 'v':
+            vcd_path = optarg;
+            break;
+        default:
+            fprintf ( stderr, "usage: %s [-g glitch_us] [-v out.vcd] dump.bin\n", argv [ 0 ] );
+            return 2;
+        }
+    }
+
+    if ( optind >= argc || !( file = fopen ( argv [ optind ], "rb" )))
+    {
+        fprintf ( stderr, "usage: %s [-g glitch_us] [-v out.vcd] dump.bin\n", argv [ 0 ] );
+        return 2;
+    }
+
+    if ( !readHeader ( file, &header ) || header.clock_hz == 0 )
+    {
+        fprintf ( stderr, "no trace header found\n" );
+        return 1;
+    }
+    edges = calloc ( header.count ? header.count : 1, sizeof ( yawTrace_t ));
+
+    if ( !edges || fread ( edges, sizeof ( yawTrace_t ), header.count, file ) != header.count )
+    {
+        fprintf ( stderr, "trace truncated, expected %u edges\n", header.count );
+        return 1;
+    }
+    fclose ( file );
+
+    double us_per_cycle = 1e6 / header.clock_hz;
+    double time_us = 0;
+    int last_quad = -1;
+    int last_ref = -1;
+
+    printf ( "%12s %4s %3s %3s %3s %5s  %s\n", "time_us", "src", "A", "B", "REF", "delta", "flags" );
+
+    for ( i = 0; i < header.count; i++ )
+    {
+        const yawTrace_t *edge = &edges [ i ];
+        char flags [ 64 ] = "";
+
+        if ( i > 0 )
+        {
+            time_us += ( uint32_t ) ( edge->time - edges [ i - 1 ].time ) * us_per_cycle;
+        }
+
+        // Compares against the previous edge from the same source
+        int *last = ( edge->source == YAW_TRACE_REF ) ? &last_ref : &last_quad;
+
+        if ( *last >= 0 && ( uint32_t ) ( edge->time - edges [ *last ].time ) * us_per_cycle < glitch_us )
+        {
+            strcat ( flags, " GLITCH" );
+            ++glitches;
+        }
+
+        if ( edge->source == YAW_TRACE_QUAD && last_quad >= 0 )
+        {
+            uint8_t changed = ( edge->pins ^ edges [ last_quad ].pins ) & QUAD_PINS;
+
+            if ( changed == 0 )
+            {
+                strcat ( flags, " MISSED" );
+                ++missed;
+            } else if ( changed == QUAD_PINS )
+            {
+                strcat ( flags, " ILLEGAL" );
+                ++illegal;
+            }
+        }
+        *last = i;
+        net += edge->delta;
+
+        printf ( "%12.1f %4s %3d %3d %3d %5d %s\n", time_us,
+                 edge->source == YAW_TRACE_REF ? "ref" : "quad",
+                 ( edge->pins & YAW_TRACE_PIN_A ) != 0,
+                 ( edge->pins & YAW_TRACE_PIN_B ) != 0,
+                 ( edge->pins & YAW_TRACE_PIN_REF ) != 0,
+                 edge->delta, flags );
+    }
+
+    printf ( "\nedges %u  net delta %d  glitches %u  missed %u  illegal %u\n",
+             header.count, net, glitches, missed, illegal );
+    printf ( "worst case trace cost %u cycles (%.2f us), handler before the trace %u cycles (%.2f us)\n",
+             header.max_cycles, header.max_cycles * us_per_cycle, header.max_isr_cycles,
+             header.max_isr_cycles * us_per_cycle );
+
+    if ( vcd_path )
+    {
+        writeVCD ( vcd_path, edges, header.count, header.clock_hz );
+    }
+    free ( edges );
+    return ( glitches || missed || illegal ) ? 1 : 0;
+}
@@ -422,7 +422,7 @@ again:
                             {
                                 ulCount = n;
                             }
-                            n = -ulCount;
+                            n -= ulCount;
 
                             while(ulCount--)
                             {
@@ -522,16 +522,21 @@ convert:
                     // If the value is negative and the value is padded with
                     // zeros, then place the minus sign before the padding.
                     //
-                    if(ulNeg && (n != 0) && (cFill == '0'))
+                    if(ulNeg && (cFill == '0'))
                     {
                         //
-                        // Place the minus sign in the output buffer.
+                        // Place the minus sign in the output buffer if there
+                        // is room.
                         //
-                        *s++ = '-';
-                        n--;
+                        if(n != 0)
+                        {
+                            *s++ = '-';
+                            n--;
+                        }
 
                         //
-                        // Update the conversion count.
+                        // Update the conversion count, even if there was not
+                        // room in the buffer.
                         //
                         iConvertCount++;
 
@@ -574,16 +579,21 @@ convert:
                     // If the value is negative, then place the minus sign
                     // before the number.
                     //
-                    if(ulNeg && (n != 0))
+                    if(ulNeg)
                     {
                         //
-                        // Place the minus sign in the output buffer.
+                        // Place the minus sign in the output buffer if there
+                        // is room.
                         //
-                        *s++ = '-';
-                        n--;
+                        if(n != 0)
+                        {
+                            *s++ = '-';
+                            n--;
+                        }
 
                         //
-                        // Update the conversion count.
+                        // Update the conversion count, even if there was not
+                        // room in the buffer.
                         //
                         iConvertCount++;
                     }
@@ -645,6 +655,15 @@ convert:
                 //
                 default:
                 {
+                    //
+                    // A '%' at the end of the format string has consumed the
+                    // null terminator, so step back onto it to stop the loop.
+                    //
+                    if(format[-1] == '\0')
+                    {
+                        format--;
+                    }
+
                     //
                     // Indicate an error.
                     //
@@ -1065,6 +1084,17 @@ umktime(struct tm *timeptr)
         iSign = ucmptime(timeptr, &sTimeGuess);
     }
 
+    //
+    // The search never tries a guess below one, so the epoch itself is only
+    // found by stepping down from there.
+    //
+    if((iSign < 0) && (ulTimeGuess == 1))
+    {
+        ulTimeGuess = 0;
+        ulocaltime(ulTimeGuess, &sTimeGuess);
+        iSign = ucmptime(timeptr, &sTimeGuess);
+    }
+
     //
     // If the above loop was exited with iSign == 0, that means that the
     // time in seconds was found, so return that value to the caller.
@@ -1143,10 +1173,14 @@ ustrtoul(const char * restrict nptr, const char ** restrict endptr, int base)
 
     //
     // See if the radix was not specified, or is 16, and the value starts with
-    // "0x" or "0X" (to indicate a hex value).
+    // "0x" or "0X" followed by a hex digit (to indicate a hex value).  A bare
+    // "0x" is the value zero, with the "x" left unconsumed.
     //
     if(((base == 0) || (base == 16)) && (*pcPtr == '0') &&
-       ((pcPtr[1] == 'x') || (pcPtr[1] == 'X')))
+       ((pcPtr[1] == 'x') || (pcPtr[1] == 'X')) &&
+       (((pcPtr[2] >= '0') && (pcPtr[2] <= '9')) ||
+        ((pcPtr[2] >= 'a') && (pcPtr[2] <= 'f')) ||
+        ((pcPtr[2] >= 'A') && (pcPtr[2] <= 'F'))))
     {
         //
         // Skip the leading "0x".
@@ -1291,6 +1325,7 @@ static const float g_pfExponents[] =
     1.0e+16,
     1.0e+32,
 };
+#define NUM_EXPONENTS           (sizeof(g_pfExponents) / sizeof(g_pfExponents[0]))
 
 //*****************************************************************************
 //
@@ -1445,7 +1480,7 @@ ustrtof(const char *nptr, const char **endptr)
         // (extracted from the table above).
         //
         fExp = 1;
-        for(ulIdx = 0; ulIdx < 7; ulIdx++)
+        for(ulIdx = 0; ulIdx < NUM_EXPONENTS; ulIdx++)
         {
             if(ulExp & (1 << ulIdx))
             {
@@ -1453,6 +1488,17 @@ ustrtof(const char *nptr, const char **endptr)
             }
         }
 
+        //
+        // Any higher exponent bit is past the range of a float, so saturate
+        // to infinity (or to zero once inverted below) rather than reading
+        // past the end of the table.
+        //
+        if(ulExp >> NUM_EXPONENTS)
+        {
+            fExp *= g_pfExponents[NUM_EXPONENTS - 1];
+            fExp *= g_pfExponents[NUM_EXPONENTS - 1];
+        }
+
         //
         // If the exponent is negative, then the exponent needs to be inverted.
         //
@@ -1462,9 +1508,13 @@ ustrtof(const char *nptr, const char **endptr)
         }
 
         //
-        // Multiply the result by the computed exponent value.
+        // Multiply the result by the computed exponent value.  A zero value
+        // stays zero, as zero times infinity would give NaN.
         //
-        fRet *= fExp;
+        if(fRet != 0)
+        {
+            fRet *= fExp;
+        }
     }
 
     //
@@ -15,28 +15,142 @@
 #include "driverlib/interrupt.h"
 #include "driverlib/pin_map.h"
 #include "./OrbitOLED/OrbitOLEDInterface.h"
+#include "display.h"
+#include "format.h"
 #include "utils/ustdlib.h"
 #include "UART.h"
+#include "yaw.h"
+#include "cycles.h"
+#include "events.h"
+#include "memory.h"
+#include "driverlib/sysctl.h"
 
 //****************************************************************************
 // Defined constants
 //****************************************************************************
 
 #define YAW_STEP                1.60714285714      // 360 degrees / (2 * 112)
+#define DEGREES_PER_REV         360.0f             // Degrees per revolution
+#define YAW_FAULT_LIMIT         20.0f              // Reference error (degrees) flagged as encoder fault
+#define YAW_CORRECTION_STEP     0.1f               // Max drift correction (degrees) per control tick
 #define DISPLAY_POS             3                  // The position on display
 #define MESSAGE_SIZE            24                 // Size of message for display
+#define YAW_TRACE_SIZE          256                // Trace entries, a power of two
 
 //****************************************************************************
 // Global variables
 //****************************************************************************
 
 volatile float g_yaw = 0;
+volatile int32_t g_yaw_ticks = 0;       // Raw quadrature count since power-up
+volatile int32_t g_ref_ticks = 0;       // Quadrature count at the reference edge
+static volatile uint32_t g_edge_time = 0;       // Cycle count of the last counted edge
+volatile bool g_yaw_dir = 0;            // Direction of the last step, 1 for increasing yaw
+volatile int8_t g_ref_key = -1;         // Edge level XOR direction marking the reference side
+volatile float g_yaw_pending = 0;       // Drift correction not yet applied to g_yaw
+volatile bool g_yaw_fault = 0;          // Set when a reference error exceeds YAW_FAULT_LIMIT
+static yawRefStats_t g_ref_stats;       // Per-pass reference error statistics
 volatile uint32_t g_pin0_state = 0;
 volatile uint32_t g_pin1_state = 0;
 volatile int g_state_11 = 0;
 volatile int g_state_00 = 0;
 
-_Bool g_ref_found = 0;
+static volatile bool g_ref_found = 0;     // Set once the reference edge has been seen
+
+#ifdef YAW_TRACE
+static yawTrace_t g_trace [ YAW_TRACE_SIZE ];   // Ring of the most recent edges
+static volatile uint32_t g_trace_index = 0;     // Total edges traced
+static volatile bool g_trace_frozen = 0;        // Set while the ring is dumped
+static uint32_t g_trace_max_cycles = 0;         // Worst case cycles spent tracing one edge
+static uint32_t g_trace_max_isr_cycles = 0;     // Worst case handler cycles ahead of the trace
+
+/**
+ * Reads the raw encoder and reference levels for the trace
+ * @return  PB0 in bit 0, PB1 in bit 1, PC4 in bit 2
+ */
+static uint8_t
+tracePins ( void )
+{
+    uint8_t pins = GPIOPinRead ( GPIO_PORTB_BASE, GPIO_PIN_0 | GPIO_PIN_1 );
+
+    if ( GPIOPinRead ( GPIO_PORTC_BASE, GPIO_PIN_4 ))
+    {
+        pins |= YAW_TRACE_PIN_REF;
+    }
+    return pins;
+}
+
+/**
+ * Records an edge in the trace ring. Constant time, called last from the
+ * yaw and reference interrupt handlers. Keeps the worst case cost of the
+ * trace itself apart from the worst case handler time before it
+ * @param time      Cycle count on entry to the handler
+ * @param source    YAW_TRACE_QUAD or YAW_TRACE_REF
+ * @param delta     Quadrature count change decoded from the edge
+ */
+static void
+traceEdge ( uint32_t time, uint8_t source, int8_t delta )
+{
+    uint32_t start = getCycles ();
+
+    if ( !g_trace_frozen )
+    {
+        yawTrace_t *entry = &g_trace [ g_trace_index & ( YAW_TRACE_SIZE - 1 ) ];
+
+        entry->time = time;
+        entry->source = source;
+        entry->pins = tracePins ();
+        entry->delta = delta;
+        entry->reserved = 0;
+        ++g_trace_index;
+    }
+    uint32_t cycles = getCycles () - start;
+
+    if ( cycles > g_trace_max_cycles )
+    {
+        g_trace_max_cycles = cycles;
+    }
+
+    if ( start - time > g_trace_max_isr_cycles )
+    {
+        g_trace_max_isr_cycles = start - time;
+    }
+}
+#endif
+
+/**
+ * Measures the accumulated yaw error when passing the reference and either
+ * queues a correction or flags an encoder fault
+ */
+static void
+checkReference ( void )
+{
+    float yaw = g_yaw + g_yaw_pending;
+    float error = yaw - DEGREES_PER_REV * floorf ( yaw / DEGREES_PER_REV + 0.5f );
+    int32_t error_ticks = ( int32_t ) floorf ( error / YAW_STEP + 0.5f );
+    int32_t abs_ticks = ( error_ticks < 0 ) ? -error_ticks : error_ticks;
+
+    ++g_ref_stats.passes;
+    g_ref_stats.last_error = error_ticks;
+
+    if ( abs_ticks > g_ref_stats.max_error )
+    {
+        g_ref_stats.max_error = abs_ticks;
+    }
+
+    if ( fabsf ( error ) > YAW_FAULT_LIMIT )
+    {
+        ++g_ref_stats.faults;
+        g_yaw_fault = 1;
+        triggerEvents ();
+#ifdef YAW_TRACE
+        g_trace_frozen = 1;     // Keeps the edges leading up to the fault
+#endif
+    } else
+    {
+        g_yaw_pending -= error;
+    }
+}
 
 /**
  * Interrupt handler for the reference g_yaw
@@ -44,18 +158,38 @@ _Bool g_ref_found = 0;
 void
 refIntHandler ( void )
 {
+#ifdef YAW_TRACE
+    uint32_t trace_time = getCycles ();
+#endif
+    traceEvent ( EVT_ISR_ENTER, EVT_ISR_REF, 0 );
+
     uint32_t int_pin = GPIOIntStatus ( GPIO_PORTC_BASE, false );
 
     if ( int_pin & GPIO_PIN_4 )
     {
         GPIOIntClear ( GPIO_PORTC_BASE, GPIO_PIN_4 );
 
+        // An edge marks the same side of the reference when level and direction agree
+        int8_t key = ( GPIOPinRead ( GPIO_PORTC_BASE, GPIO_PIN_4 ) != 0 ) ^ g_yaw_dir;
+
         if ( !g_ref_found )
         {
             g_yaw = 0;
+            g_ref_ticks = g_yaw_ticks;
+            g_ref_key = key;
             g_ref_found = 1;
+        } else if ( g_ref_key < 0 )
+        {
+            g_ref_key = key;
+        } else if ( key == g_ref_key )
+        {
+            checkReference ();
         }
+#ifdef YAW_TRACE
+        traceEdge ( trace_time, YAW_TRACE_REF, 0 );
+#endif
     }
+    traceEvent ( EVT_ISR_EXIT, EVT_ISR_REF, 0 );
 }
 
 /**
@@ -64,6 +198,11 @@ refIntHandler ( void )
 void
 yawIntHandler ( void )
 {
+    uint32_t edge_time = getCycles ();
+    int32_t start_ticks = g_yaw_ticks;
+
+    traceEvent ( EVT_ISR_ENTER, EVT_ISR_YAW, 0 );
+
     uint32_t int_pin = GPIOIntStatus ( GPIO_PORTB_BASE, false );
 
     // If an interrupt is triggered from PB0 pin
@@ -82,6 +221,8 @@ yawIntHandler ( void )
             if ( g_pin1_state )
             {
                 g_yaw -= YAW_STEP;
+                --g_yaw_ticks;
+                g_yaw_dir = 0;
             }
         }
 
@@ -92,6 +233,8 @@ yawIntHandler ( void )
             if ( g_pin0_state )
             {
                 g_yaw -= YAW_STEP;
+                --g_yaw_ticks;
+                g_yaw_dir = 0;
             }
         }
     }
@@ -109,6 +252,8 @@ yawIntHandler ( void )
             if ( g_pin0_state )
             {
                 g_yaw += YAW_STEP;
+                ++g_yaw_ticks;
+                g_yaw_dir = 1;
             }
         }
 
@@ -119,6 +264,8 @@ yawIntHandler ( void )
             if ( g_pin1_state )
             {
                 g_yaw += YAW_STEP;
+                ++g_yaw_ticks;
+                g_yaw_dir = 1;
             }
         }
     }
@@ -132,6 +279,16 @@ yawIntHandler ( void )
     {
         g_state_00 = 1;
     }
+
+    // Stamps only edges that moved the count, for the latency statistics
+    if ( g_yaw_ticks != start_ticks )
+    {
+        g_edge_time = edge_time;
+    }
+#ifdef YAW_TRACE
+    traceEdge ( edge_time, YAW_TRACE_QUAD, g_yaw_ticks - start_ticks );
+#endif
+    traceEvent ( EVT_ISR_EXIT, EVT_ISR_YAW, 0 );
 }
 
 /**
@@ -142,6 +299,9 @@ initYaw ( void )
 {
     GPIOIntRegister ( GPIO_PORTB_BASE, yawIntHandler );
     GPIOIntRegister ( GPIO_PORTC_BASE, refIntHandler );
+#ifdef YAW_TRACE
+    registerMemory ( "yaw trace", sizeof ( g_trace ));
+#endif
 
     // Initialize pins on port B
     GPIOPinTypeGPIOInput ( GPIO_PORTB_BASE, GPIO_PIN_0 );
@@ -181,6 +341,143 @@ initYaw ( void )
     IntEnable ( INT_GPIOC );
 }
 
+/**
+ * Returns the raw quadrature count since power-up
+ * @return The quadrature count
+ */
+int32_t
+getYawTicks ( void )
+{
+    return g_yaw_ticks;
+}
+
+/**
+ * Returns the time of the last edge that changed the yaw
+ * @return The cycle count when the edge interrupt ran
+ */
+uint32_t
+getYawTime ( void )
+{
+    return g_edge_time;
+}
+
+/**
+ * Returns the quadrature count at which the reference edge was found
+ * @return The reference edge count
+ */
+int32_t
+getRefTicks ( void )
+{
+    return g_ref_ticks;
+}
+
+/**
+ * Returns whether the reference edge has been found, or restored from the
+ * stored configuration
+ * @return True once yaw is measured from the reference
+ */
+bool
+isYawReferenced ( void )
+{
+    return g_ref_found;
+}
+
+/**
+ * Restores a yaw measured relative to the reference before power down,
+ * marking the reference as found so calibration can be skipped
+ * @param yaw   The stored yaw in degrees
+ */
+void
+restoreYawReference ( float yaw )
+{
+    IntMasterDisable ();
+    g_yaw = yaw;
+    g_ref_found = 1;
+    g_ref_key = -1;     // The reference side is learnt on the next pass
+    IntMasterEnable ();
+}
+
+/**
+ * Applies queued reference drift correction to the yaw, limited to
+ * YAW_CORRECTION_STEP per call so the tail loop sees no step change
+ */
+void
+updateYawCorrection ( void )
+{
+    IntMasterDisable ();
+    float step = g_yaw_pending;
+
+    if ( step > YAW_CORRECTION_STEP )
+    {
+        step = YAW_CORRECTION_STEP;
+    } else if ( step < -YAW_CORRECTION_STEP )
+    {
+        step = -YAW_CORRECTION_STEP;
+    }
+    g_yaw += step;
+    g_yaw_pending -= step;
+    IntMasterEnable ();
+}
+
+/**
+ * Returns the reference error statistics gathered on each pass
+ * @return The reference error statistics
+ */
+yawRefStats_t
+getYawRefStats ( void )
+{
+    yawRefStats_t stats;
+
+    IntMasterDisable ();
+    stats = g_ref_stats;
+    IntMasterEnable ();
+    return stats;
+}
+
+/**
+ * Returns whether a reference pass has disagreed with the encoder by more
+ * than the fault limit
+ * @return True if an encoder fault has been flagged
+ */
+bool
+isYawFault ( void )
+{
+    return g_yaw_fault;
+}
+
+/**
+ * Sends the edge trace over UART as a yawTraceHeader_t followed by the
+ * traced edges, oldest first. Tracing pauses while the dump is sent.
+ * Does nothing unless built with YAW_TRACE
+ */
+void
+dumpYawTrace ( void )
+{
+#ifdef YAW_TRACE
+    yawTraceHeader_t header;
+    uint32_t count;
+    uint32_t first;
+    uint32_t i;
+
+    g_trace_frozen = 1;
+    count = ( g_trace_index < YAW_TRACE_SIZE ) ? g_trace_index : YAW_TRACE_SIZE;
+    first = g_trace_index - count;
+
+    header.magic = YAW_TRACE_MAGIC;
+    header.clock_hz = SysCtlClockGet ();
+    header.count = count;
+    header.max_cycles = g_trace_max_cycles;
+    header.max_isr_cycles = g_trace_max_isr_cycles;
+    sendUARTbytes (( uint8_t * ) &header, sizeof ( header ));
+
+    for ( i = 0; i < count; i++ )
+    {
+        sendUARTbytes (( uint8_t * ) &g_trace [ ( first + i ) & ( YAW_TRACE_SIZE - 1 ) ], sizeof ( yawTrace_t ));
+    }
+    g_trace_frozen = 0;
+#endif
+}
+
 /**
  * Display the helicopter rigs current yaw
  */
@@ -188,8 +485,10 @@ void
 displayYaw ( void )
 {
     char message [ MESSAGE_SIZE ];
-    usprintf ( message, "yaw: %4d ", ( int ) g_yaw );
-    OLEDStringDraw ( message, 0, DISPLAY_POS );
+    char *end = formatLiteral ( message, "yaw: " );
+    end = formatInt ( end, ( int ) g_yaw, 4 );
+    formatLiteral ( end, " " );
+    displayString ( message, 0, DISPLAY_POS );
 }
 
 /**
@@ -7,12 +7,116 @@
 #ifndef YAW_H_
 #define YAW_H_
 
+#include <stdint.h>
+#include <stdbool.h>
+
+// Yaw reference error statistics, errors in quadrature ticks
+typedef struct {
+    uint32_t passes;        // Reference passes checked
+    uint32_t faults;        // Passes beyond the fault limit
+    int32_t last_error;     // Error on the last pass
+    int32_t max_error;      // Largest absolute error
+} yawRefStats_t;
+
+// Edge trace, built in with YAW_TRACE and decoded by tools/yawtrace.c
+#define YAW_TRACE_MAGIC         0x43525459      // "YTRC"
+#define YAW_TRACE_QUAD          0               // Edge on PB0 or PB1
+#define YAW_TRACE_REF           1               // Edge on PC4
+#define YAW_TRACE_PIN_A         0x01            // PB0 level
+#define YAW_TRACE_PIN_B         0x02            // PB1 level
+#define YAW_TRACE_PIN_REF       0x04            // PC4 level
+
+// Trace dump header, sent little-endian ahead of the edge records
+typedef struct {
+    uint32_t magic;         // YAW_TRACE_MAGIC
+    uint32_t clock_hz;      // CPU clock for converting timestamps
+    uint32_t count;         // Number of yawTrace_t records that follow
+    uint32_t max_cycles;    // Worst case cycles spent in traceEdge for one edge
+    uint32_t max_isr_cycles;    // Worst case handler cycles before traceEdge
+} yawTraceHeader_t;
+
+// One traced edge
+typedef struct {
+    uint32_t time;          // DWT cycle count on handler entry
+    uint8_t source;         // YAW_TRACE_QUAD or YAW_TRACE_REF
+    uint8_t pins;           // Raw levels, YAW_TRACE_PIN_* bits
+    int8_t delta;           // Quadrature count change decoded from the edge
+    uint8_t reserved;
+} yawTrace_t;
+
 /**
  * Initialize the yaw interrupt ports
  */
 void
 initYaw ( void );
 
+/**
+ * Returns the raw quadrature count since power-up
+ * @return The quadrature count
+ */
+int32_t
+getYawTicks ( void );
+
+/**
+ * Returns the time of the last edge that changed the yaw
+ * @return The cycle count when the edge interrupt ran
+ */
+uint32_t
+getYawTime ( void );
+
+/**
+ * Returns the quadrature count at which the reference edge was found
+ * @return The reference edge count
+ */
+int32_t
+getRefTicks ( void );
+
+/**
+ * Returns whether the reference edge has been found, or restored from the
+ * stored configuration
+ * @return True once yaw is measured from the reference
+ */
+bool
+isYawReferenced ( void );
+
+/**
+ * Restores a yaw measured relative to the reference before power down,
+ * marking the reference as found so calibration can be skipped
+ * @param yaw   The stored yaw in degrees
+ */
+void
+restoreYawReference ( float yaw );
+
+/**
+ * Applies queued reference drift correction to the yaw, limited to
+ * YAW_CORRECTION_STEP per call so the tail loop sees no step change
+ */
+void
+updateYawCorrection ( void );
+
+/**
+ * Returns the reference error statistics gathered on each pass
+ * @return The reference error statistics
+ */
+yawRefStats_t
+getYawRefStats ( void );
+
+/**
+ * Returns whether a reference pass has disagreed with the encoder by more
+ * than the fault limit
+ * @return True if an encoder fault has been flagged
+ */
+bool
+isYawFault ( void );
+
+/**
+ * Sends the edge trace over UART as a yawTraceHeader_t followed by the
+ * traced edges, oldest first. Tracing pauses while the dump is sent.
+ * Does nothing unless built with YAW_TRACE
+ */
+void
+dumpYawTrace ( void );
+
 /**
  * Display the helicopter rigs current yaw
  */